@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Fixed-size text kept in relaxed atomic words, for strings published under a sequence
+// lock: a reader may copy it while the writer rewrites it without a data race, and the
+// sequence counter tells it whether the copy is whole. Size counts the terminator, and
+// longer text is truncated.
+template <size_t Size>
+class AtomicText {
+public:
+    static_assert(Size % sizeof(uint64_t) == 0, "AtomicText size must be a whole number of words");
+
+    void store(const std::string& text) {
+        char bytes[Size] = {};
+        text.copy(bytes, Size - 1);
+        for (size_t i = 0; i < WORDS; ++i) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+            words[i].store(word, std::memory_order_relaxed);
+        }
+    }
+
+    // Copies the text into out, which is always terminated.
+    void copyTo(char (&out)[Size]) const {
+        for (size_t i = 0; i < WORDS; ++i) {
+            uint64_t word = words[i].load(std::memory_order_relaxed);
+            std::memcpy(out + i * sizeof(uint64_t), &word, sizeof(uint64_t));
+        }
+        out[Size - 1] = '\0';
+    }
+
+private:
+    static const size_t WORDS = Size / sizeof(uint64_t);
+    std::atomic<uint64_t> words[WORDS] = {};
+};
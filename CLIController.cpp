@@ -1,6 +1,7 @@
 #include "CLIController.h"
 #include "Screen.h"
 #include "ScreenManager.h"
+#include "Clock.h"
 #include <ctime>
 #include <sstream>
 #include <string>
@@ -22,6 +23,13 @@ const string CLIController::COLOR_RED = "\033[38;2;240;128;128m";
 const string CLIController::COLOR_BLUE = "\033[38;5;37m";
 const string CLIController::COLOR_RESET = "\033[0m";
 
+// Defines the ANSI cursor and erase sequences used to redraw a view in place.
+const string CLIController::CURSOR_HOME = "\033[H";
+const string CLIController::CLEAR_LINE_END = "\033[K";
+const string CLIController::CLEAR_BELOW = "\033[J";
+const string CLIController::HIDE_CURSOR = "\033[?25l";
+const string CLIController::SHOW_CURSOR = "\033[?25h";
+
 // Initializes the singleton instance of the CLIController.
 void CLIController::initialize() {
 	if (!instance) instance = new CLIController();
@@ -32,18 +40,9 @@ CLIController* CLIController::getInstance() {
 	return instance;
 }
 
-// Returns the current system time as a formatted string, thread-safe.
+// Returns the current system time as a formatted string, thread-safe and lock-free.
 string CLIController::getTimestamp() const {  
-	// Lock mutex to ensure thread safety for time operations.
-    std::lock_guard<std::mutex> lock(timestampMutex);  
-
-    time_t now = time(0);  
-    tm localtm;  
-    localtime_s(&localtm, &now); 
-
-    stringstream ss;  
-    ss << put_time(&localtm, "%m/%d/%Y, %I:%M:%S %p");  
-    return ss.str();  
+    return Clock::now();
 }
 
 // Prints the main ASCII art header for the console.
@@ -85,6 +84,9 @@ void CLIController::drawScreen(const Screen& screen) const {
 	if (screen.isFinished() && !screen.hasMemoryViolation()) {
 		cout << "Status           : Finished at " << screen.getTimestampFinished() << "\n";
 	}
+	else if (screen.isBlockedOnPageFault()) {
+		cout << "Status           : Blocked on page fault\n";
+	}
 	else if (screen.getIsRunning()) {
 		cout << "Status           : Running on Core " << screen.getCoreID() << "\n";
 	}
@@ -113,6 +115,33 @@ void CLIController::clearScreen() const {
 	}
 }
 
+// Clears the terminal and hides the cursor before the first frame of a live view.
+void CLIController::beginLiveView() const {
+	cout << "\033[2J" << CURSOR_HOME << HIDE_CURSOR << flush;
+}
+
+// Overwrites the previous frame from the top-left corner. Each line is erased past its
+// end and anything below the frame is cleared, so shorter frames leave no leftovers and
+// the screen never goes blank between frames. The frame is written in one go.
+void CLIController::redrawLiveView(const string& frame) const {
+	string output = CURSOR_HOME;
+	size_t start = 0;
+	while (start < frame.size()) {
+		size_t end = frame.find('\n', start);
+		if (end == string::npos) end = frame.size();
+		output.append(frame, start, end - start);
+		output += CLEAR_LINE_END + "\n";
+		start = end + 1;
+	}
+	output += CLEAR_BELOW;
+	cout << output << flush;
+}
+
+// Restores the cursor after a live view; the last frame stays on screen.
+void CLIController::endLiveView() const {
+	cout << SHOW_CURSOR << flush;
+}
+
 // Destroys the singleton instance to free memory.
 void CLIController::destroy() {
 	delete instance;
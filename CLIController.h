@@ -17,15 +17,23 @@ public:
 	void drawScreen(const Screen& screen) const;
 	void clearScreen() const;
 
+	// In-place Views (ANSI cursor control, for live displays such as 'top')
+	void beginLiveView() const;
+	void redrawLiveView(const std::string& frame) const;
+	void endLiveView() const;
 
 	// ANSI Color Constants
 	static const std::string COLOR_GREEN;
 	static const std::string COLOR_RED;
 	static const std::string COLOR_BLUE;
 	static const std::string COLOR_RESET;
+	static const std::string CURSOR_HOME;
+	static const std::string CLEAR_LINE_END;
+	static const std::string CLEAR_BELOW;
+	static const std::string HIDE_CURSOR;
+	static const std::string SHOW_CURSOR;
 
 private:
 	CLIController(); 
 	static CLIController* instance;
-	mutable std::mutex timestampMutex;
 };
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "Clock.h"
+#include <iomanip>
+#include <sstream>
+using namespace std;
+
+Clock::Cache Clock::cache;
+std::atomic<bool> Clock::refreshing{ false };
+
+time_t Clock::wallTime() {
+    return time(nullptr);
+}
+
+// Formats a wall-clock time as "%m/%d/%Y, %I:%M:%S %p" in local time.
+string Clock::format(time_t time) {
+    tm localtm;
+#ifdef _WIN32
+    localtime_s(&localtm, &time);
+#else
+    localtime_r(&time, &localtm);
+#endif
+
+    stringstream ss;
+    ss << put_time(&localtm, "%m/%d/%Y, %I:%M:%S %p");
+    return ss.str();
+}
+
+// Returns the formatted current time. The first caller in a new second reformats the
+// cache; everyone else copies it. A reader that races with the refresh formats its own.
+string Clock::now() {
+    time_t second = wallTime();
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        uint64_t before = cache.sequence.load(memory_order_acquire);
+        if ((before & 1) == 0 && cache.second.load(memory_order_relaxed) == second) {
+            char copy[TEXT_SIZE];
+            cache.text.copyTo(copy);
+            atomic_thread_fence(memory_order_acquire);
+            if (cache.sequence.load(memory_order_relaxed) == before) return string(copy);
+        }
+        if (!refresh(second)) break;
+    }
+    return format(second);
+}
+
+// Rewrites the cache for the given second. Returns false if another thread is already doing it.
+bool Clock::refresh(time_t second) {
+    if (refreshing.exchange(true, memory_order_acquire)) return false;
+    if (cache.second.load(memory_order_relaxed) >= second) {
+        // Another thread already moved the cache to this second or a later one.
+        refreshing.store(false, memory_order_release);
+        return true;
+    }
+    string text = format(second);
+
+    uint64_t sequence = cache.sequence.load(memory_order_relaxed);
+    cache.sequence.store(sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    cache.text.store(text);
+    cache.second.store(second, memory_order_relaxed);
+    cache.sequence.store(sequence + 2, memory_order_release);
+
+    refreshing.store(false, memory_order_release);
+    return true;
+}
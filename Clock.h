@@ -0,0 +1,36 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include "AtomicText.h"
+
+// Time source for the whole emulator. Internal timings use the monotonic nanosecond
+// clock and wall-clock times are stored as time_t; both are formatted only for display.
+// now() serves the "%m/%d/%Y, %I:%M:%S %p" string of the current second from a cache
+// guarded by a sequence lock, so the cores never format or lock to get a timestamp.
+class Clock {
+public:
+    static long long monotonicNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    static std::time_t wallTime();
+
+    // Formatting
+    static std::string format(std::time_t time);
+    static std::string now(); // format(wallTime()), refreshed at most once per second
+
+private:
+    static bool refresh(std::time_t second);
+
+    static const size_t TEXT_SIZE = 32;
+    struct Cache {
+        std::atomic<uint64_t> sequence{ 0 }; // odd while the text is being rewritten
+        std::atomic<std::time_t> second{ -1 };
+        AtomicText<TEXT_SIZE> text;
+    };
+    static Cache cache;
+    static std::atomic<bool> refreshing;
+};
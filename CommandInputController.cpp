@@ -2,9 +2,12 @@
 #include "ScreenManager.h"
 #include "Kernel.h"
 #include "CLIController.h"
+#include "Clock.h"
 #include "Scheduler.h"
 #include "Instruction.h"
 #include "MemoryManager.h"
+#include "ReportWriter.h"
+#include "MetricsExporter.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -35,8 +38,6 @@ CommandInputController* CommandInputController::getInstance() {
 }
 
 
-vector<Instruction> parseInstructions(const string& input);
-
 // Parses a single token into a variable or a literal value Operand.
 Operand parseOperand(const string& token) {
     if (isalpha(token[0])) { // It's a variable
@@ -196,6 +197,7 @@ void CommandInputController::destroy() {
 
 // The core command router; directs string commands to the appropriate functions.
 void CommandInputController::commandHandler(string command) {
+    commandRejected = false;
     if (ScreenManager::getInstance()->getCurrentScreen()->getName() == "main") {
         if (command == "initialize") {
             if (Kernel::getInstance()->isConfigInitialized()) {
@@ -206,6 +208,8 @@ void CommandInputController::commandHandler(string command) {
                 Kernel::getInstance()->setConfigInitialized(true);
                 Scheduler::getInstance()->start();
                 cout << "Initialized successfully.\n";
+                cout << "Random seed: " << Scheduler::getInstance()->getRunSeed()
+                    << (Scheduler::getInstance()->isReplaying() ? " (replaying arrival log)" : "") << "\n";
             }
         }
         else if (command == "exit") {
@@ -219,9 +223,20 @@ void CommandInputController::commandHandler(string command) {
             cout << "screen -ls          : List all available screens\n";
             cout << "scheduler-start     : Start the process scheduler\n";
             cout << "scheduler-stop      : Stop the process scheduler\n";
-            cout << "report-util         : Save a report to 'csopesy-log.txt'\n";
+            cout << "report-util         : Write a report to 'csopesy-log.txt' in the background\n";
             cout << "process-smi         : Display system and memory summary\n"; 
             cout << "vmstat              : Display virtual memory statistics\n"; 
+            cout << "vmstat -h [ticks]   : Per-tick history of the last ticks, with rates and trend\n";
+            cout << "vmstat <interval> [count] : Print deltas and rates every interval ticks\n";
+            cout << "metrics [json]      : Print all counters in Prometheus text format, or as JSON\n";
+            cout << "top [-n <frames>]   : Live dashboard of cores, queues and rates; Enter returns\n";
+            cout << "memtrace <file>     : Record memory accesses to a binary trace file\n";
+            cout << "memtrace stop       : Stop recording memory accesses\n";
+            cout << "trace-start         : Record scheduler events in per-core ring buffers\n";
+            cout << "trace-stop          : Stop recording scheduler events\n";
+            cout << "trace-dump <file>   : Export recorded scheduler events as Chrome trace JSON\n";
+            cout << "lockstat [on|off|reset] : Show lock contention statistics, or control profiling\n";
+            cout << "process-prof [on|off|<name>] : Profile instructions; no name shows generated processes\n";
             cout << "clear               : Clear the screen\n";
             cout << "exit                : Exit program\n";
         }
@@ -231,6 +246,7 @@ void CommandInputController::commandHandler(string command) {
         }
         else if (!Kernel::getInstance()->isConfigInitialized()) {
             cout << "Initialize first" << endl;
+            commandRejected = true;
             return;
         }
         else if (command.rfind("screen", 0) == 0) {
@@ -240,39 +256,30 @@ void CommandInputController::commandHandler(string command) {
             ss >> subcommand; // Get subcommand
 
             if (subcommand == "-ls") {
-                auto allScreens = ScreenManager::getInstance()->getAllScreens();
-                vector<shared_ptr<Screen>> runningProcesses;
+                // Active processes come in arrival order and finished ones in completion order.
+                ProcessRegistry::Snapshot processes = ScreenManager::getInstance()->snapshotProcesses();
+                const vector<shared_ptr<Screen>>& runningProcesses = processes.active;
                 vector<shared_ptr<Screen>> finishedProcesses;
+                finishedProcesses.reserve(processes.finished.size());
 
-                for (const auto& pair : allScreens) {
-                    if (pair.first == "main") continue;
-                    auto screen = pair.second;
-
-                    if (screen->hasMemoryViolation()) {
-                        // Extract time from timestamp
-                        string timeOnly = screen->getMemoryViolationTime();
-                        size_t timeStart = timeOnly.find(", ") + 2;
-                        size_t timeEnd = timeOnly.find(" ", timeStart);
-                        if (timeEnd != string::npos) {
-                            timeOnly = timeOnly.substr(timeStart, timeEnd - timeStart);
-                        }
-
-                        cout << "Process " << screen->getName()
-                            << " shut down due to memory access violation error that occurred at "
-                            << timeOnly << ". " << screen->getMemoryViolationAddress()
-                            << " invalid." << endl;
-                    }
-                    else if (screen->isFinished()) {
+                for (const auto& screen : processes.finished) {
+                    if (!screen->hasMemoryViolation()) {
                         finishedProcesses.push_back(screen);
+                        continue;
                     }
-                    else {
-                        runningProcesses.push_back(screen);
+                    // Extract time from timestamp
+                    string timeOnly = screen->getMemoryViolationTime();
+                    size_t timeStart = timeOnly.find(", ") + 2;
+                    size_t timeEnd = timeOnly.find(" ", timeStart);
+                    if (timeEnd != string::npos) {
+                        timeOnly = timeOnly.substr(timeStart, timeEnd - timeStart);
                     }
-                }
 
-                //sort by creation timestamp
-                sort(runningProcesses.begin(), runningProcesses.end(), [](const auto& a, const auto& b) { return a->getTimestamp() < b->getTimestamp(); });
-                sort(finishedProcesses.begin(), finishedProcesses.end(), [](const auto& a, const auto& b) { return a->getTimestamp() < b->getTimestamp(); });
+                    cout << "Process " << screen->getName()
+                        << " shut down due to memory access violation error that occurred at "
+                        << timeOnly << ". " << screen->getMemoryViolationAddress()
+                        << " invalid." << endl;
+                }
 
                 cout << "CPU utilization: " << (Scheduler::getInstance()->getUsedCores() * 100 / Scheduler::getInstance()->getAvailableCores()) << "%" << endl;
                 cout << "Cores used: " << Scheduler::getInstance()->getUsedCores() << endl;
@@ -288,11 +295,15 @@ void CommandInputController::commandHandler(string command) {
                         cout << left << setw(10) << screen->getName()
                             << " (" << screen->getTimestamp() << ")";
 
-                        if (screen->getCoreID() != -1) {
+                        if (screen->isBlockedOnPageFault()) {
+                            cout << "\tBlocked";
+                        }
+                        else if (screen->getCoreID() != -1) {
                             cout << "\tCore: " << screen->getCoreID();
                         }
 
-                        cout << "\t" << screen->getProgramCounter() << " / " << screen->getTotalInstructions() << "\n";
+                        cout << "\t" << screen->getProgramCounter() << " / " << screen->getTotalInstructions()
+                            << formatMetrics(screen->getMetrics(), false) << "\n";
                     }
                 }
 
@@ -305,9 +316,11 @@ void CommandInputController::commandHandler(string command) {
                         cout << left << setw(10) << screen->getName()
                             << " (" << screen->getTimestampFinished() << ")"
                             << "\tFinished"
-                            << "\t" << screen->getProgramCounter() << " / " << screen->getTotalInstructions() << "\n";
+                            << "\t" << screen->getProgramCounter() << " / " << screen->getTotalInstructions()
+                            << formatMetrics(screen->getMetrics(), true) << "\n";
                     }
                 }
+                writeSchedulingSummary(cout, finishedProcesses);
                 cout << "--------------------------------------------------------------------------------\n";
 
             }
@@ -315,6 +328,7 @@ void CommandInputController::commandHandler(string command) {
                 ss >> screenName >> memorySizeStr;
                 if (screenName.empty() || memorySizeStr.empty()) {
                     cout << "Usage: screen -s <name> <memory_size>\n";
+                    commandRejected = true;
                     return;
                 }
                 else {
@@ -323,21 +337,26 @@ void CommandInputController::commandHandler(string command) {
 
                         if (!isPowerOfTwo(memSize)) {
                             cout << "Invalid memory allocation. Size must be a power of 2.\n";
+                            commandRejected = true;
                             return;
                         }
                         
                         if (memSize < 64 || memSize > 65536) { // Memory validation
                             cout << "Invalid memory allocation. Size must be between 64 and 65536 bytes.\n";
+                            commandRejected = true;
                         }
                         else if (ScreenManager::getInstance()->hasScreen(screenName)) {
                             cout << "Screen '" << screenName << "' already exists.\n";
+                            commandRejected = true;
                         }
                         else {
-                            auto newInstructions = Scheduler::getInstance()->generateInstructionsForProcess(screenName, memSize);
-                            auto newScreen = make_shared<Screen>(screenName, newInstructions, CLIController::getInstance()->getTimestamp());
+                            unsigned long long programSeed = Scheduler::getInstance()->getProgramSeed(screenName);
+                            auto newInstructions = Scheduler::getInstance()->generateInstructionsForProcess(screenName, memSize, programSeed);
+                            Scheduler::getInstance()->logArrival(screenName, memSize, programSeed);
+                            auto newScreen = make_shared<Screen>(screenName, newInstructions, Clock::wallTime());
 
                             // Setup memory in the MemoryManager first
-                            MemoryManager::getInstance()->setupProcessMemory(screenName, memSize);
+                            MemoryManager::getInstance()->setupProcessMemory(screenName, memSize, newScreen->getFaultCounters());
 
                             ScreenManager::getInstance()->registerScreen(screenName, newScreen);
                             Scheduler::getInstance()->addProcessToQueue(newScreen);
@@ -347,6 +366,7 @@ void CommandInputController::commandHandler(string command) {
                     }
                     catch (const std::invalid_argument&) {
                         cout << "Invalid memory size provided. Please enter a number.\n";
+                        commandRejected = true;
                     }
                 }
             }
@@ -354,10 +374,12 @@ void CommandInputController::commandHandler(string command) {
                 ss >> screenName;
                 if (screenName.empty()) {
                     cout << "Usage: screen -r <name>\n";
+                    commandRejected = true;
                 }
                 // Check if the screen name exists at all.
                 else if (!ScreenManager::getInstance()->hasScreen(screenName)) {
                     cout << "Process '" << screenName << "' not found.\n";
+                    commandRejected = true;
                 }
                 else {
                     auto screen = ScreenManager::getInstance()->getScreen(screenName);
@@ -372,8 +394,15 @@ void CommandInputController::commandHandler(string command) {
                             << " invalid." << endl;
                     }
                     else if(screen->isFinished()) {
-                        //check process if finished
-                        cout << "Process '" << screenName << "' not found.\n";
+                        // A finished process cannot be attached to, so print its log instead;
+                        // once archived, the log is read back from the archive file.
+                        vector<string> lines = screen->isArchived()
+                            ? ScreenManager::getInstance()->getArchive().read(screenName)
+                            : screen->getOutputBuffer();
+                        cout << "Process '" << screenName << "' finished at " << screen->getTimestampFinished()
+                            << (screen->isArchived() ? ". Log (archived):\n" : ". Log:\n");
+                        for (const auto& line : lines) cout << line << "\n";
+                        if (lines.empty()) cout << "(No output)\n";
                     }
                     else {
                         ScreenManager::getInstance()->switchScreen(screenName);
@@ -390,6 +419,7 @@ void CommandInputController::commandHandler(string command) {
 
                 if (processName.empty() || memorySizeStr.empty() || firstQuote == string::npos || lastQuote == string::npos || firstQuote == lastQuote) {
                     cout << "Usage: screen -c <name> <memory_size> \"<instructions>\"\n";
+                    commandRejected = true;
                     return;
                 }
 
@@ -399,14 +429,17 @@ void CommandInputController::commandHandler(string command) {
                     int memSize = stoi(memorySizeStr);
                     if (!isPowerOfTwo(memSize)) {
                         cout << "Invalid memory allocation. Size must be a power of 2.\n";
+                        commandRejected = true;
                         return;
                     }
                     if (memSize < 64 || memSize > 65536) {
                         cout << "Invalid memory allocation. Size must be between 64 and 65536 bytes.\n";
+                        commandRejected = true;
                         return;
                     }
                     if (ScreenManager::getInstance()->hasScreen(processName)) {
                         cout << "Screen '" << processName << "' already exists.\n";
+                        commandRejected = true;
                         return;
                     }
 
@@ -416,13 +449,15 @@ void CommandInputController::commandHandler(string command) {
                     // Validate instruction 
                     if (userInstructions.empty() || userInstructions.size() > 50) {
                         cout << "Invalid command: Instruction count must be between 1 and 50.\n";
+                        commandRejected = true;
                         return;
                     }
 
                     // Create and register the new screen with the parsed instructions
-                    auto newScreen = make_shared<Screen>(processName, userInstructions, CLIController::getInstance()->getTimestamp());
-                    MemoryManager::getInstance()->setupProcessMemory(processName, memSize);
+                    auto newScreen = make_shared<Screen>(processName, userInstructions, Clock::wallTime());
+                    MemoryManager::getInstance()->setupProcessMemory(processName, memSize, newScreen->getFaultCounters());
                     ScreenManager::getInstance()->registerScreen(processName, newScreen);
+                    Scheduler::getInstance()->logArrival(processName, memSize, instructionsStr);
                     Scheduler::getInstance()->addProcessToQueue(newScreen);
 
                     cout << "Process '" << processName << "' created successfully with " << userInstructions.size() << " instructions." << endl;
@@ -430,13 +465,16 @@ void CommandInputController::commandHandler(string command) {
                 }
                 catch (const invalid_argument& e) {
                     cout << "Invalid memory size provided: " << e.what() << endl;
+                    commandRejected = true;
                 }
                 catch (const runtime_error& e) {
                     cout << "Error parsing instructions: " << e.what() << endl;
+                    commandRejected = true;
                 }
             }
             else {
 				cout << "Unknown screen command '" << subcommand << " \n";
+				commandRejected = true;
             }
         }
         else if (command == "scheduler-start") {
@@ -452,6 +490,7 @@ void CommandInputController::commandHandler(string command) {
             }
             else {
                 cout << "Scheduler is not running. Please 'initialize' the kernel first.\n";
+                commandRejected = true;
             }
         }
         else if (command == "scheduler-stop") {
@@ -467,76 +506,179 @@ void CommandInputController::commandHandler(string command) {
             }
             else {
                 cout << "Scheduler is not running.\n";
+                commandRejected = true;
             }
         }
         else if (command == "report-util") {
-            auto allScreens = ScreenManager::getInstance()->getAllScreens();
-            vector<shared_ptr<Screen>> runningProcesses;
-            vector<shared_ptr<Screen>> finishedProcesses;
-
-            for (const auto& pair : allScreens) {
-                if (pair.first == "main") continue;
-                auto screen = pair.second;
-                if (screen->getProgramCounter() >= screen->getTotalInstructions() && screen->getTotalInstructions() > 0) {
-                    finishedProcesses.push_back(screen);
+            // Written by the Scheduler's report thread so this command returns at once.
+            ReportWriter& reporter = Scheduler::getInstance()->getReporter();
+            reporter.requestReport();
+            cout << "Screen list report queued for '" << reporter.getPath() << "'.\n";
+		}
+        else if (command == "process-smi") {
+            ScreenManager::getInstance()->displaySystemSmiSummary();
+        }
+        else if (command.rfind("vmstat", 0) == 0) {
+            stringstream ss(command);
+            string token, argument;
+            ss >> token >> argument;
+            if (argument.empty()) {
+                ScreenManager::getInstance()->displayVmStat();
+                return;
+            }
+            try {
+                if (argument == "-h") {
+                    string ticks;
+                    ss >> ticks;
+                    ScreenManager::getInstance()->displayVmStatHistory(ticks.empty() ? 20 : max(1, stoi(ticks)));
                 }
                 else {
-                    runningProcesses.push_back(screen);
+                    string count;
+                    ss >> count;
+                    int interval = stoi(argument);
+                    if (interval <= 0) throw invalid_argument(argument);
+                    ScreenManager::getInstance()->displayVmStatSeries(interval, count.empty() ? 10 : max(1, stoi(count)));
                 }
             }
-
-            //sort by creation timestamp for FCFS ordering
-            sort(runningProcesses.begin(), runningProcesses.end(), [](const auto& a, const auto& b) { return a->getTimestamp() < b->getTimestamp(); });
-            sort(finishedProcesses.begin(), finishedProcesses.end(), [](const auto& a, const auto& b) { return a->getTimestamp() < b->getTimestamp(); });
-
-            ofstream logFile("csopesy-log.txt"); //overwrite text
-            if (!logFile) {
-                cout << "Failed to open report file.\n";
+            catch (const exception&) {
+                cout << "Usage: vmstat | vmstat -h [ticks] | vmstat <interval-ticks> [count]\n";
+                commandRejected = true;
+            }
+        }
+        else if (command == "metrics" || command == "metrics json") {
+            vector<MetricSample> samples = MetricsExporter::collect();
+            if (command == "metrics") MetricsExporter::writePrometheus(cout, samples);
+            else MetricsExporter::writeJson(cout, samples);
+        }
+        else if (command.rfind("top", 0) == 0) {
+            stringstream ss(command);
+            string token, option;
+            int frames = 0;
+            ss >> token >> option;
+            if (token != "top" || (!option.empty() && (option != "-n" || !(ss >> frames) || frames <= 0))) {
+                cout << "Usage: top [-n <frames>]\n";
+                commandRejected = true;
+                return;
+            }
+            if (frames == 0 && scripted) {
+                cout << "top waits for Enter, which a script cannot send. Use top -n <frames>.\n";
+                commandRejected = true;
                 return;
             }
-            logFile << "CPU utilization: " << (Scheduler::getInstance()->getUsedCores() * 100 / Scheduler::getInstance()->getAvailableCores()) << "%" << endl;
-            logFile << "Cores used: " << Scheduler::getInstance()->getUsedCores() << endl;
-            logFile << "Cores available: " << Scheduler::getInstance()->getAvailableCores() << endl;
-            logFile << "--------------------------------------------------------------------------------\n";
-            logFile << "Running processes:\n";
-            if (runningProcesses.empty()) {
-                logFile << " (None)\n";
+            ScreenManager::getInstance()->displayTop(frames);
+        }
+        else if (command == "trace-start" || command == "trace-stop" || command.rfind("trace-dump", 0) == 0) {
+            Scheduler* scheduler = Scheduler::getInstance();
+            if (!scheduler || !scheduler->getSchedulerRunning()) {
+                cout << "Scheduler is not running. Please 'initialize' the kernel first.\n";
+                commandRejected = true;
+                return;
+            }
+            SchedulerEventTrace& trace = scheduler->getEventTrace();
+
+            if (command == "trace-start") {
+                trace.start();
+                cout << "Recording scheduler events.\n";
+            }
+            else if (command == "trace-stop") {
+                trace.stop();
+                cout << "Scheduler event recording stopped.\n";
             }
             else {
-                for (const auto& screen : runningProcesses) {
-                    logFile << left << setw(10) << screen->getName()
-                        << " (" << screen->getTimestamp() << ")";
-                    if (screen->getCoreID() != -1) {
-                        logFile << "\tCore: " << screen->getCoreID();
-                    }
-                    logFile << "\t" << screen->getProgramCounter() << " / " << screen->getTotalInstructions() << "\n";
+                stringstream ss(command);
+                string token, path;
+                ss >> token >> path;
+                if (path.empty()) {
+                    cout << "Usage: trace-dump <file>\n";
+                    commandRejected = true;
+                }
+                else if (trace.exportChromeTrace(path)) {
+                    cout << "Wrote " << trace.snapshot().size() << " events to '" << path << "' ("
+                        << trace.getOverwrittenCount() << " overwritten). Open it in ui.perfetto.dev or chrome://tracing.\n";
+                }
+                else {
+                    cout << "Failed to write trace file '" << path << "'.\n";
+                    commandRejected = true;
                 }
             }
+        }
+        else if (command.rfind("process-prof", 0) == 0) {
+            stringstream ss(command);
+            string token, argument;
+            ss >> token >> argument;
+
+            if (argument == "on" || argument == "off") {
+                ProcessProfile::setEnabled(argument == "on");
+                cout << "Instruction profiling " << (argument == "on" ? "enabled" : "disabled") << ".\n";
+            }
+            else if (argument.empty()) {
+                ScreenManager::getInstance()->displayGeneratedProfile();
+            }
+            else {
+                ScreenManager::getInstance()->displayProcessProfile(argument);
+            }
+        }
+        else if (command.rfind("lockstat", 0) == 0) {
+            stringstream ss(command);
+            string token, argument;
+            ss >> token >> argument;
 
-            logFile << "\nFinished processes:\n";
-            if (finishedProcesses.empty()) {
-                logFile << " (None)\n";
+            if (argument == "on" || argument == "off") {
+                ProfiledMutex::setProfilingEnabled(argument == "on");
+                cout << "Lock profiling " << (argument == "on" ? "enabled" : "disabled") << ".\n";
+            }
+            else if (argument == "reset") {
+                ProfiledMutex::resetAllStats();
+                cout << "Lock statistics cleared.\n";
+            }
+            else if (!argument.empty()) {
+                cout << "Usage: lockstat [on|off|reset]\n";
+                commandRejected = true;
             }
             else {
-                for (const auto& screen : finishedProcesses) {
-                    logFile << left << setw(10) << screen->getName()
-                        << " (" << screen->getTimestampFinished() << ")"
-                        << "\tFinished"
-                        << "\t" << screen->getProgramCounter() << " / " << screen->getTotalInstructions() << "\n";
+                if (!ProfiledMutex::isProfilingEnabled()) {
+                    cout << "Lock profiling is off; use 'lockstat on' to start collecting.\n";
+                }
+                ios::fmtflags flags = cout.flags();
+                streamsize precision = cout.precision();
+                cout << left << setw(32) << "Lock" << right << setw(12) << "Acquired" << setw(12) << "Contended"
+                    << setw(14) << "Wait total" << setw(12) << "Wait max" << setw(14) << "Hold total" << setw(12) << "Hold max" << "\n";
+                cout << fixed << setprecision(2);
+                for (const LockStats& lock : ProfiledMutex::getAllStats()) {
+                    cout << left << setw(32) << lock.name << right << setw(12) << lock.acquisitions << setw(12) << lock.contended
+                        << setw(12) << lock.totalWaitNanos / 1e6 << "ms" << setw(10) << lock.maxWaitNanos / 1e3 << "us"
+                        << setw(12) << lock.totalHoldNanos / 1e6 << "ms" << setw(10) << lock.maxHoldNanos / 1e3 << "us" << "\n";
                 }
+                cout.flags(flags);
+                cout.precision(precision);
             }
-            logFile << "--------------------------------------------------------------------------------\n";
-            logFile.close();
-            cout << "Screen list report saved to 'csopesy-log.txt'.\n";
-		}
-        else if (command == "process-smi") {
-            ScreenManager::getInstance()->displaySystemSmiSummary();
         }
-        else if (command == "vmstat") {
-            ScreenManager::getInstance()->displayVmStat(); 
+        else if (command.rfind("memtrace", 0) == 0) {
+            stringstream ss(command);
+            string token, argument;
+            ss >> token >> argument;
+            MemoryManager* memManager = MemoryManager::getInstance();
+
+            if (argument.empty()) {
+                cout << "Usage: memtrace <file> | memtrace stop\n";
+                commandRejected = true;
+            }
+            else if (argument == "stop") {
+                long long records = memManager->getTraceRecordCount();
+                memManager->stopTrace();
+                cout << "Memory trace stopped after " << records << " records.\n";
+            }
+            else if (memManager->startTrace(argument, []() { return Scheduler::getInstance()->getCpuCycles(); })) {
+                cout << "Recording memory accesses to '" << argument << "'.\n";
+            }
+            else {
+                cout << "Failed to open trace file '" << argument << "'.\n";
+                commandRejected = true;
+            }
         }
         else {
             cout << "Unknown command '" << command << "'. Type 'help' for available commands.\n";
+            commandRejected = true;
         }
     }
     else { // if inside a specific process screen
@@ -552,12 +694,17 @@ void CommandInputController::commandHandler(string command) {
 			cout << "exit                : Return to main console\n";
 			cout << "clear               : Clear the screen\n";
 			cout << "process-smi         : Display process SMI (State, Memory, and I/O)\n";
+			cout << "process-prof        : Display this process's instruction profile\n";
 		}
         else if (command == "process-smi") {
             ScreenManager::getInstance()->displayProcessSMI();
         }
+        else if (command == "process-prof") {
+            ScreenManager::getInstance()->displayProcessProfile(ScreenManager::getInstance()->getCurrentScreen()->getName());
+        }
         else {
             cout << "Unknown command '" << command << "'. Type 'exit' to return to the main console.\n";
+            commandRejected = true;
         }
     } 
 
@@ -568,4 +715,90 @@ void CommandInputController::startInputLoop() {
     while (Kernel::getInstance()->getRunningStatus()) {
         handleInputEntry(); // Your existing function already has the logic
     }
+}
+
+// Runs commands from a script file or piped input, one per line, then exits. Blank lines
+// and lines starting with '#' are skipped, and report-util waits until its report is
+// written. A script can also wait on the simulation:
+//   wait-ticks <n>             until n more CPU ticks have passed
+//   wait-idle [max-ticks]      until no process is running or ready
+//   wait-finished [max-ticks]  until every process created so far has finished
+// Returns 0 if every command was accepted and every wait completed, 1 otherwise.
+int CommandInputController::runScript(istream& input) {
+    int status = 0;
+    scripted = true;
+    string line;
+    while (Kernel::getInstance()->getRunningStatus() && getline(input, line)) {
+        string command = trim(line);
+        if (command.empty() || command[0] == '#') continue;
+        cout << CLIController::COLOR_GREEN << (ScreenManager::getInstance()->getCurrentScreen()->getName() + " > ")
+            << CLIController::COLOR_RESET << command << "\n";
+
+        if (command.rfind("wait-", 0) == 0) {
+            if (!runWaitDirective(command)) status = 1;
+            continue;
+        }
+        commandHandler(command);
+        if (commandRejected) status = 1;
+        else if (command == "report-util") Scheduler::getInstance()->getReporter().waitUntilWritten();
+    }
+
+    if (Kernel::getInstance()->getRunningStatus()) {
+        cout << "End of script. Exiting program...\n";
+        Kernel::getInstance()->setRunningStatus(false);
+    }
+    return status;
+}
+
+// Blocks until a wait-ticks, wait-idle or wait-finished condition holds. Returns false on a
+// malformed directive, a timeout, or if the program exits first.
+bool CommandInputController::runWaitDirective(const string& command) {
+    stringstream ss(command);
+    string directive;
+    int ticks = -1;
+    ss >> directive;
+    if (!(ss >> ticks)) ticks = -1;
+
+    Scheduler* scheduler = Scheduler::getInstance();
+    if (!Kernel::getInstance()->isConfigInitialized() || !scheduler || !scheduler->getSchedulerRunning()) {
+        cout << "Initialize first" << endl;
+        return false;
+    }
+    ScreenManager* screens = ScreenManager::getInstance();
+    auto activeProcesses = [screens]() {
+        return screens->getProcessCount(ProcessState::READY) + screens->getProcessCount(ProcessState::RUNNING);
+    };
+
+    const int start = scheduler->getCpuCycles();
+    int limit = ticks; // max ticks to wait; -1 = no limit
+    function<bool()> done;
+    if (directive == "wait-ticks" && ticks >= 0) {
+        limit = -1;
+        done = [scheduler, start, ticks]() { return scheduler->getCpuCycles() >= start + ticks; };
+    }
+    else if (directive == "wait-idle") {
+        done = [scheduler, activeProcesses]() { return activeProcesses() == 0 && scheduler->getUsedCores() == 0; };
+    }
+    else if (directive == "wait-finished") {
+        // A NEW process is registered but not queued yet, so it still counts as unfinished.
+        done = [screens, activeProcesses]() {
+            return activeProcesses() == 0 && screens->getProcessCount(ProcessState::BLOCKED) == 0
+                && screens->getProcessCount(ProcessState::NEW) == 0;
+        };
+    }
+    else {
+        cout << "Usage: wait-ticks <n> | wait-idle [max-ticks] | wait-finished [max-ticks]\n";
+        return false;
+    }
+
+    while (!done()) {
+        if (!Kernel::getInstance()->getRunningStatus()) return false;
+        if (limit >= 0 && scheduler->getCpuCycles() - start >= limit) {
+            cout << "Timed out after " << limit << " ticks.\n";
+            return false;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    cout << "Resumed at tick " << scheduler->getCpuCycles() << ".\n";
+    return true;
 }
\ No newline at end of file
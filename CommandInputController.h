@@ -1,6 +1,13 @@
 #pragma once
 #include "CLIController.h"
+#include "Instruction.h"
+#include <istream>
 #include <string>
+#include <vector>
+
+// Parses a semicolon-separated program such as "DECLARE x 5; PRINT(\"x=\" + x)".
+// Throws runtime_error on malformed input.
+std::vector<Instruction> parseInstructions(const std::string& input);
 
 
 class CommandInputController {
@@ -13,9 +20,15 @@ public:
 	// Input Loop
 	void startInputLoop();
 
+	// Script Mode
+	int runScript(std::istream& input); // runs every line, then exits; returns the exit status
+
 private:
 	CommandInputController();
 	void handleInputEntry();
+	bool runWaitDirective(const std::string& command);
 	static CommandInputController* instance;
 	void commandHandler(std::string command);
+	bool commandRejected = false; // set when the last command was unknown or not allowed yet
+	bool scripted = false; // set by runScript, where no key can end a live view
 };
\ No newline at end of file
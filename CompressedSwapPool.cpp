@@ -0,0 +1,149 @@
+#include "CompressedSwapPool.h"
+#include <algorithm>
+using namespace std;
+
+// A header word with this bit set encodes a run of one repeated word; otherwise it
+// is followed by that many literal words.
+static const uint16_t RUN_FLAG = 0x8000;
+static const size_t MAX_CHUNK = 0x7FFF;
+
+// Constructor: sets the pool's size cap and the handler that writes spilled pages to disk.
+CompressedSwapPool::CompressedSwapPool(size_t maxBytes, SpillHandler spillHandler)
+    : maxBytes(maxBytes), spillHandler(std::move(spillHandler)) {
+}
+
+// Compresses and stores a page. Returns false if the page does not compress or cannot fit,
+// in which case the caller should write it to the backing store directly.
+bool CompressedSwapPool::store(const string& processId, int pageNumber, const uint16_t* data, size_t words) {
+    vector<uint16_t> compressed;
+    compress(data, words, compressed);
+
+    size_t compressedBytes = compressed.size() * sizeof(uint16_t);
+    if (compressedBytes >= words * sizeof(uint16_t) || compressedBytes > maxBytes) {
+        rejectedPages++;
+        return false;
+    }
+
+    // Replace any stale copy of the same page.
+    auto existing = entries.find({ processId, pageNumber });
+    if (existing != entries.end()) removeEntry(existing);
+
+    while (usedBytes + compressedBytes > maxBytes && !lru.empty()) {
+        spillOldest();
+    }
+
+    lru.push_front({ processId, pageNumber });
+    entries[{ processId, pageNumber }] = { std::move(compressed), words, lru.begin() };
+    usedBytes += compressedBytes;
+    storedPages++;
+    return true;
+}
+
+// Decompresses a stored page into data and removes it from the pool.
+bool CompressedSwapPool::load(const string& processId, int pageNumber, uint16_t* data, size_t words) {
+    auto it = entries.find({ processId, pageNumber });
+    if (it == entries.end()) return false;
+
+    bool ok = decompress(it->second.compressed, data, words);
+    removeEntry(it);
+    return ok;
+}
+
+// Checks whether a page currently lives in the pool.
+bool CompressedSwapPool::contains(const string& processId, int pageNumber) const {
+    return entries.find({ processId, pageNumber }) != entries.end();
+}
+
+// Drops every page belonging to a process without writing it back.
+void CompressedSwapPool::eraseProcess(const string& processId) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->first.processId == processId) {
+            auto next = std::next(it);
+            removeEntry(it);
+            it = next;
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+// Removes an entry and releases its accounted space.
+void CompressedSwapPool::removeEntry(unordered_map<PageKey, Entry, PageKeyHash>::iterator it) {
+    usedBytes -= it->second.compressed.size() * sizeof(uint16_t);
+    storedPages--;
+    lru.erase(it->second.lruPosition);
+    entries.erase(it);
+}
+
+// Writes the least recently stored page out through the spill handler.
+void CompressedSwapPool::spillOldest() {
+    PageKey oldest = lru.back();
+    auto it = entries.find(oldest);
+    if (it == entries.end()) {
+        lru.pop_back();
+        return;
+    }
+
+    vector<uint16_t> page(it->second.words);
+    decompress(it->second.compressed, page.data(), page.size());
+
+    removeEntry(it);
+    spilledPages++;
+    if (spillHandler) spillHandler(oldest.processId, oldest.pageNumber, page);
+}
+
+// Run-length encodes a page: repeated words collapse to a two-word run, others stay literal.
+void CompressedSwapPool::compress(const uint16_t* data, size_t words, vector<uint16_t>& out) {
+    out.clear();
+    size_t i = 0;
+    while (i < words) {
+        size_t run = 1;
+        while (i + run < words && data[i + run] == data[i] && run < MAX_CHUNK) run++;
+
+        if (run >= 3) {
+            out.push_back(static_cast<uint16_t>(RUN_FLAG | run));
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+
+        // Gather literals until the next run of three or more begins.
+        size_t start = i;
+        while (i < words && i - start < MAX_CHUNK) {
+            if (i + 2 < words && data[i] == data[i + 1] && data[i] == data[i + 2]) break;
+            i++;
+        }
+        out.push_back(static_cast<uint16_t>(i - start));
+        out.insert(out.end(), data + start, data + i);
+    }
+}
+
+// Decodes a run-length encoded page. Returns false if the input does not describe exactly words words.
+bool CompressedSwapPool::decompress(const vector<uint16_t>& in, uint16_t* data, size_t words) {
+    size_t out = 0;
+    size_t i = 0;
+    while (i < in.size()) {
+        uint16_t header = in[i++];
+        size_t count = header & MAX_CHUNK;
+        if (out + count > words) return false;
+
+        if (header & RUN_FLAG) {
+            if (i >= in.size()) return false;
+            fill(data + out, data + out + count, in[i++]);
+        }
+        else {
+            if (i + count > in.size()) return false;
+            copy(in.begin() + i, in.begin() + i + count, data + out);
+            i += count;
+        }
+        out += count;
+    }
+    return out == words;
+}
+
+size_t CompressedSwapPool::getMaxBytes() const { return maxBytes; }
+size_t CompressedSwapPool::getUsedBytes() const { return usedBytes.load(); }
+int CompressedSwapPool::getStoredPageCount() const { return storedPages.load(); }
+int CompressedSwapPool::getSpilledCount() const { return spilledPages.load(); }
+int CompressedSwapPool::getRejectedCount() const { return rejectedPages.load(); }
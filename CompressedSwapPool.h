@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// An in-memory pool of compressed evicted pages that sits in front of the backing store file.
+// Pages are run-length encoded; when the pool exceeds its size cap the least recently stored
+// pages are decompressed and handed to the spill callback to be written to disk.
+// The pool is not internally synchronized; callers must hold the memory manager's lock.
+class CompressedSwapPool {
+public:
+    using SpillHandler = std::function<void(const std::string& processId, int pageNumber, const std::vector<uint16_t>& data)>;
+
+    CompressedSwapPool(size_t maxBytes, SpillHandler spillHandler);
+
+    // Page Operations
+    bool store(const std::string& processId, int pageNumber, const uint16_t* data, size_t words);
+    bool load(const std::string& processId, int pageNumber, uint16_t* data, size_t words);
+    bool contains(const std::string& processId, int pageNumber) const;
+    void eraseProcess(const std::string& processId);
+
+    // Statistics
+    size_t getMaxBytes() const;
+    size_t getUsedBytes() const;
+    int getStoredPageCount() const;
+    int getSpilledCount() const;
+    int getRejectedCount() const;
+
+    // Word-oriented run-length codec
+    static void compress(const uint16_t* data, size_t words, std::vector<uint16_t>& out);
+    static bool decompress(const std::vector<uint16_t>& in, uint16_t* data, size_t words);
+
+private:
+    struct PageKey {
+        std::string processId;
+        int pageNumber;
+        bool operator==(const PageKey& other) const {
+            return pageNumber == other.pageNumber && processId == other.processId;
+        }
+    };
+    struct PageKeyHash {
+        size_t operator()(const PageKey& key) const {
+            return std::hash<std::string>()(key.processId) ^ (std::hash<int>()(key.pageNumber) << 1);
+        }
+    };
+    struct Entry {
+        std::vector<uint16_t> compressed;
+        size_t words;
+        std::list<PageKey>::iterator lruPosition;
+    };
+
+    void removeEntry(std::unordered_map<PageKey, Entry, PageKeyHash>::iterator it);
+    void spillOldest();
+
+    size_t maxBytes;
+    SpillHandler spillHandler;
+
+    std::list<PageKey> lru; // front = most recently stored
+    std::unordered_map<PageKey, Entry, PageKeyHash> entries;
+
+    std::atomic<size_t> usedBytes{ 0 };
+    std::atomic<int> storedPages{ 0 };
+    std::atomic<int> spilledPages{ 0 };
+    std::atomic<int> rejectedPages{ 0 };
+};
@@ -0,0 +1,70 @@
+#include "LatencyHistogram.h"
+#include <sstream>
+#include <iomanip>
+using namespace std;
+
+// Constructor: clears every bucket.
+LatencyHistogram::LatencyHistogram() {
+    for (auto& bucket : buckets) bucket.store(0, memory_order_relaxed);
+}
+
+// Adds one sample. Only relaxed atomic increments, so it is cheap to call on the fault path.
+void LatencyHistogram::record(long long nanoseconds) {
+    if (nanoseconds < 0) nanoseconds = 0;
+    buckets[bucketFor(nanoseconds)].fetch_add(1, memory_order_relaxed);
+    count.fetch_add(1, memory_order_relaxed);
+    totalNanos.fetch_add(nanoseconds, memory_order_relaxed);
+
+    long long currentMax = maxNanos.load(memory_order_relaxed);
+    while (nanoseconds > currentMax && !maxNanos.compare_exchange_weak(currentMax, nanoseconds, memory_order_relaxed)) {
+    }
+}
+
+// Returns the index of the bucket holding the sample: the bit width of the value.
+int LatencyHistogram::bucketFor(long long nanoseconds) {
+    int bucket = 0;
+    while (nanoseconds > 0 && bucket < BUCKET_COUNT - 1) {
+        nanoseconds >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+long long LatencyHistogram::getCount() const { return count.load(memory_order_relaxed); }
+long long LatencyHistogram::getMaxNanos() const { return maxNanos.load(memory_order_relaxed); }
+
+// Returns the mean sample value in nanoseconds.
+double LatencyHistogram::getAverageNanos() const {
+    long long samples = getCount();
+    return samples > 0 ? static_cast<double>(totalNanos.load(memory_order_relaxed)) / samples : 0.0;
+}
+
+// Returns the upper bound of the bucket containing the given percentile (0-100), capped at the max sample.
+long long LatencyHistogram::percentileNanos(double percentile) const {
+    long long samples = getCount();
+    if (samples == 0) return 0;
+
+    long long rank = static_cast<long long>(samples * percentile / 100.0);
+    if (rank >= samples) rank = samples - 1;
+
+    long long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i].load(memory_order_relaxed);
+        if (seen > rank) {
+            long long upper = (i == 0) ? 0 : (1LL << i) - 1;
+            return upper < getMaxNanos() ? upper : getMaxNanos();
+        }
+    }
+    return getMaxNanos();
+}
+
+// Formats count, p50, p99 and max in microseconds for display.
+string LatencyHistogram::summary() const {
+    stringstream ss;
+    ss << fixed << setprecision(1)
+        << "n=" << getCount()
+        << " p50=" << percentileNanos(50) / 1000.0 << "us"
+        << " p99=" << percentileNanos(99) / 1000.0 << "us"
+        << " max=" << getMaxNanos() / 1000.0 << "us";
+    return ss.str();
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <atomic>
+#include <string>
+
+// A lock-free latency histogram with power-of-two buckets.
+// Bucket i counts samples in [2^(i-1), 2^i) nanoseconds, so percentiles are
+// reported as the upper bound of the bucket they fall in.
+class LatencyHistogram {
+public:
+    static const int BUCKET_COUNT = 48;
+
+    LatencyHistogram();
+
+    // Recording
+    void record(long long nanoseconds);
+
+    // Statistics
+    long long getCount() const;
+    long long getMaxNanos() const;
+    double getAverageNanos() const;
+    long long percentileNanos(double percentile) const;
+    std::string summary() const;
+
+private:
+    static int bucketFor(long long nanoseconds);
+
+    std::atomic<long long> buckets[BUCKET_COUNT];
+    std::atomic<long long> count{ 0 };
+    std::atomic<long long> totalNanos{ 0 };
+    std::atomic<long long> maxNanos{ 0 };
+};
@@ -5,6 +5,8 @@
 #include <sstream>
 #include <iomanip>
 #include <numeric>
+#include <algorithm>
+#include <chrono>
 using namespace std;
 
 // Singleton & Mutex
@@ -46,43 +48,52 @@ MemoryManager::MemoryManager(int totalMemory, int frameSize)
     ofstream("csopesy-backing-store.txt", ios::trunc).close();
 }
 
+// Destructor: stops the page merging scanner and the pager if they are still running.
+MemoryManager::~MemoryManager() {
+    stopPageMerging();
+    stopPager();
+}
+
 // Creates the initial page table for a new process based on its required memory size.
-bool MemoryManager::setupProcessMemory(const string& processId, int size) {
-    lock_guard<std::mutex> lock(memory_mutex_);
+bool MemoryManager::setupProcessMemory(const string& processId, int size, shared_ptr<ProcessFaultCounters> faults) {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
     int num_pages_required = (size + frameSize - 1) / frameSize; // Ceiling division
 
-    process_page_tables[processId] = PageTable(num_pages_required);
+    PageTable& page_table = process_page_tables[processId];
+    page_table = PageTable(num_pages_required);
+    page_table.faults = move(faults);
     return true;
 }
 
 // Releases all memory frames allocated to a specific process.
 void MemoryManager::deallocate(const std::string& processId) {
-    std::lock_guard<std::mutex> lock(memory_mutex_);
+    std::lock_guard<ProfiledMutex> lock(memory_mutex_);
     if (process_page_tables.find(processId) == process_page_tables.end()) return;
 
-    // Iterate the process's page table and release each valid frame.
-    for (const auto& pte : process_page_tables.at(processId)) {
-        if (pte.valid) {
-            int frame_num = pte.frameNumber;
-            frame_table[frame_num].allocated = false;
-            frame_table[frame_num].processId = "";
-            frame_table[frame_num].pageNumber = -1;
-            free_frame_list.push_back(frame_num);
+    // Iterate the process's page table and release each valid mapping.
+    // Shared frames stay allocated while other pages still map them.
+    const auto& page_table = process_page_tables.at(processId);
+    for (int page_num = 0; page_num < static_cast<int>(page_table.size()); ++page_num) {
+        if (page_table[page_num].valid) {
+            releaseMapping(page_table[page_num].frameNumber, processId, page_num);
         }
     }
+    if (compressed_pool) compressed_pool->eraseProcess(processId);
+    if (trace_recorder) trace_recorder->record(processId, 0, TraceAccessKind::RELEASE);
     process_page_tables.erase(processId);
 }
 
 
 // Reads a value from a process's logical memory; triggers a page fault if needed.
 bool MemoryManager::readMemory(const string& processId, uint16_t address, uint16_t& value) {
-    std::lock_guard<std::mutex> lock(memory_mutex_);
+    std::lock_guard<ProfiledMutex> lock(memory_mutex_);
     if (process_page_tables.find(processId) == process_page_tables.end()) return false;
 
     int page_num = address / frameSize;
     int offset = address % frameSize;
 
     if (page_num >= process_page_tables.at(processId).size()) return false; // Access violation
+    if (trace_recorder) trace_recorder->record(processId, page_num, TraceAccessKind::READ);
 
     if (!process_page_tables.at(processId)[page_num].valid) {
         if (handlePageFault(processId, page_num) == -1) return false;
@@ -96,19 +107,22 @@ bool MemoryManager::readMemory(const string& processId, uint16_t address, uint16
 
 // Writes a value to a process's logical memory; triggers a page fault if needed.
 bool MemoryManager::writeMemory(const std::string& processId, uint16_t address, uint16_t value) {
-    std::lock_guard<std::mutex> lock(memory_mutex_);
+    std::lock_guard<ProfiledMutex> lock(memory_mutex_);
     if (process_page_tables.find(processId) == process_page_tables.end()) return false;
 
     int page_num = address / frameSize;
     int offset = address % frameSize;
 
     if (page_num >= process_page_tables.at(processId).size()) return false; // Access violation
+    if (trace_recorder) trace_recorder->record(processId, page_num, TraceAccessKind::WRITE);
 
     if (!process_page_tables.at(processId)[page_num].valid) {
         if (handlePageFault(processId, page_num) == -1) return false;
     }
 
     auto& pte = process_page_tables.at(processId)[page_num];
+    if (pte.cow && !breakCopyOnWrite(processId, page_num)) return false;
+
     int frame_num = pte.frameNumber;
     int physical_address = (frame_num * frameSize + offset) / sizeof(uint16_t);
     physical_memory[physical_address] = value;
@@ -116,50 +130,358 @@ bool MemoryManager::writeMemory(const std::string& processId, uint16_t address,
     return true;
 }
 
+// Returns the pages behind the given addresses that are valid for the process but not resident.
+// Out-of-range addresses are skipped; they surface as access violations when executed.
+std::vector<int> MemoryManager::getMissingPages(const std::string& processId, const std::vector<uint16_t>& addresses) const {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    vector<int> missing;
+    auto it = process_page_tables.find(processId);
+    if (it == process_page_tables.end()) return missing;
+
+    for (uint16_t address : addresses) {
+        int page_num = address / frameSize;
+        if (page_num >= static_cast<int>(it->second.size()) || it->second[page_num].valid) continue;
+        if (find(missing.begin(), missing.end(), page_num) == missing.end()) {
+            missing.push_back(page_num);
+        }
+    }
+    return missing;
+}
+
+// Queues pages to be loaded by the pager thread; onComplete runs on the pager thread once they are in.
+void MemoryManager::requestPageIn(const std::string& processId, const std::vector<int>& pages, std::function<void()> onComplete) {
+    {
+        lock_guard<mutex> lock(pager_mutex);
+        pager_queue.push_back({ processId, pages, std::move(onComplete) });
+    }
+    pager_cv.notify_one();
+}
+
+// Starts the pager thread that services asynchronous page-in requests.
+void MemoryManager::startPager() {
+    lock_guard<mutex> lock(pager_mutex);
+    if (pager_running) return;
+    pager_running = true;
+    pager_thread = thread(&MemoryManager::pagerLoop, this);
+}
+
+// Stops the pager thread once it has served the requests still queued, so every
+// blocked requester is woken and put back in the ready queue.
+void MemoryManager::stopPager() {
+    {
+        lock_guard<mutex> lock(pager_mutex);
+        pager_running = false;
+    }
+    pager_cv.notify_all();
+    if (pager_thread.joinable()) {
+        pager_thread.join();
+    }
+}
+
+// Pager thread body: performs the victim writeback and page read for each request, then wakes the requester.
+void MemoryManager::pagerLoop() {
+    while (true) {
+        PageInRequest request;
+        {
+            unique_lock<mutex> lock(pager_mutex);
+            pager_cv.wait(lock, [this]() { return !pager_queue.empty() || !pager_running; });
+            if (pager_queue.empty()) return; // stopped, and nothing left to serve
+            request = std::move(pager_queue.front());
+            pager_queue.pop_front();
+        }
+
+        {
+            lock_guard<ProfiledMutex> lock(memory_mutex_);
+            auto it = process_page_tables.find(request.processId);
+            if (it != process_page_tables.end()) {
+                for (int page_num : request.pages) {
+                    // The page may have been loaded by a synchronous fault in the meantime.
+                    if (page_num < static_cast<int>(it->second.size()) && !it->second[page_num].valid) {
+                        handlePageFault(request.processId, page_num);
+                        async_page_ins++;
+                    }
+                }
+            }
+        }
+
+        if (request.onComplete) request.onComplete();
+    }
+}
+
+// Returns the number of pages loaded by the pager thread on behalf of blocked processes.
+int MemoryManager::getAsyncPageInCount() const {
+    return async_page_ins.load();
+}
+
 // Handles a page fault by finding a frame, evicting if necessary, and loading the required page.
 int MemoryManager::handlePageFault(const std::string& processId, int pageNumber) {
-    int target_frame;
+    auto fault_start = chrono::steady_clock::now();
+
+    // A page that never reached the backing store is all zeros; share the zero frame instead of loading it.
+    PageTable& page_table = process_page_tables.at(processId);
+    if (!page_table[pageNumber].swapped && mapZeroPage(processId, pageNumber)) {
+        if (page_table.faults) page_table.faults->minorFaults++;
+        minor_faults++;
+        fault_service_latency.record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - fault_start).count());
+        return zero_frame;
+    }
+
+    int target_frame = allocateFrame();
+
+    // Try the compressed pool first; the backing store file is the slow path.
+    auto load_start = chrono::steady_clock::now();
+    int physical_address = (target_frame * frameSize) / sizeof(uint16_t);
+    bool from_pool = compressed_pool &&
+        compressed_pool->load(processId, pageNumber, &physical_memory[physical_address], frameSize / sizeof(uint16_t));
+    if (!from_pool) {
+        readPageFromBackingStore(processId, pageNumber, target_frame);
+    }
+    auto load_end = chrono::steady_clock::now();
+    long long load_ns = chrono::duration_cast<chrono::nanoseconds>(load_end - load_start).count();
+    (from_pool ? compressed_load_latency : backing_store_read_latency).record(load_ns);
+    pages_paged_in++; 
+    if (page_table.faults) page_table.faults->majorFaults++;
+    major_faults++;
+
+    // A freshly loaded page starts with no sharers and no pins.
+    Frame& loaded = frame_table[target_frame];
+    loaded = Frame{};
+    loaded.allocated = true;
+    loaded.processId = processId;
+    loaded.pageNumber = pageNumber;
+    auto& pte = page_table[pageNumber];
+    pte.frameNumber = target_frame;
+    pte.valid = true;
+    // A page loaded from the pool left it, so the frame now holds the only up-to-date copy.
+    pte.dirty = from_pool;
+    pte.cow = false;
+
+    fault_service_latency.record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - fault_start).count());
+    return target_frame;
+}
 
+// Takes a frame from the free list, or evicts a victim frame when none are free.
+int MemoryManager::allocateFrame() {
     if (!free_frame_list.empty()) {
-        target_frame = free_frame_list.front();
+        int frame_num = free_frame_list.front();
         free_frame_list.pop_front();
+        used_frames++;
+        return frame_num;
+    }
+
+    int victim = findVictimFrame();
+    evictFrame(victim);
+    return victim;
+}
+
+// Unmaps every page that references a frame, writing the owner back if it is dirty.
+void MemoryManager::evictFrame(int frameNumber) {
+    auto& victim_frame_info = frame_table[frameNumber];
+
+    // Check if the victim frame is actually associated with a process
+    if (process_page_tables.count(victim_frame_info.processId)) {
+        auto& victim_pte = process_page_tables.at(victim_frame_info.processId)[victim_frame_info.pageNumber];
+        if (victim_pte.dirty) {
+            auto writeback_start = chrono::steady_clock::now();
+            int physical_address = (frameNumber * frameSize) / sizeof(uint16_t);
+            if (!compressed_pool ||
+                !compressed_pool->store(victim_frame_info.processId, victim_frame_info.pageNumber,
+                    &physical_memory[physical_address], frameSize / sizeof(uint16_t))) {
+                writePageToBackingStore(frameNumber);
+            }
+            writeback_latency.record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - writeback_start).count());
+            pages_paged_out++;
+            victim_pte.swapped = true;
+        }
+        victim_pte.valid = false;
+        victim_pte.frameNumber = -1;
+        victim_pte.cow = false;
+        victim_pte.pinned = false;
+    }
+
+    // Merged pages are always clean, so their sharers can simply be invalidated.
+    for (const auto& sharer : victim_frame_info.sharers) {
+        if (!process_page_tables.count(sharer.first)) continue;
+        auto& sharer_pte = process_page_tables.at(sharer.first)[sharer.second];
+        sharer_pte.valid = false;
+        sharer_pte.frameNumber = -1;
+        sharer_pte.cow = false;
+        sharer_pte.pinned = false;
+    }
+    frames_saved -= static_cast<int>(victim_frame_info.sharers.size());
+    if (victim_frame_info.pinCount > 0) pinned_frames--; // only when every frame was pinned
+
+    if (frameNumber == zero_frame) zero_frame = -1;
+    victim_frame_info = Frame{};
+}
+
+// Removes one page's mapping from a frame, freeing the frame once nothing maps it.
+void MemoryManager::releaseMapping(int frameNumber, const std::string& processId, int pageNumber) {
+    auto& frame = frame_table[frameNumber];
+
+    auto& released_pte = process_page_tables.at(processId)[pageNumber];
+    if (released_pte.pinned) {
+        unpinFrame(frameNumber);
+        released_pte.pinned = false;
+    }
+
+    if (frame.processId == processId && frame.pageNumber == pageNumber) {
+        if (frame.sharers.empty()) {
+            if (frameNumber == zero_frame) zero_frame = -1;
+            frame = Frame{};
+            free_frame_list.push_back(frameNumber);
+            used_frames--;
+            return;
+        }
+        // Promote one of the sharers to be the frame's owner.
+        frame.processId = frame.sharers.back().first;
+        frame.pageNumber = frame.sharers.back().second;
+        frame.sharers.pop_back();
     }
     else {
-        target_frame = findVictimFrame();
-        const auto& victim_frame_info = frame_table[target_frame];
-
-        // Check if the victim frame is actually associated with a process
-        if (process_page_tables.count(victim_frame_info.processId)) {
-            auto& victim_pte = process_page_tables.at(victim_frame_info.processId)[victim_frame_info.pageNumber];
-            if (victim_pte.dirty) {
-                writePageToBackingStore(target_frame);
-                pages_paged_out++;
+        for (auto it = frame.sharers.begin(); it != frame.sharers.end(); ++it) {
+            if (it->first == processId && it->second == pageNumber) {
+                frame.sharers.erase(it);
+                break;
             }
-            victim_pte.valid = false;
-            victim_pte.frameNumber = -1;
         }
     }
+    frames_saved--;
 
-    readPageFromBackingStore(processId, pageNumber, target_frame);
-    pages_paged_in++; 
+    // The last remaining mapping owns the frame privately again.
+    if (frame.sharers.empty() && frameNumber != zero_frame && process_page_tables.count(frame.processId)) {
+        process_page_tables.at(frame.processId)[frame.pageNumber].cow = false;
+    }
+}
 
-    frame_table[target_frame] = { true, processId, pageNumber }; 
-    auto& pte = process_page_tables.at(processId)[pageNumber];
+// Gives a page its own private copy of a merged frame before it is written.
+bool MemoryManager::breakCopyOnWrite(const std::string& processId, int pageNumber) {
+    PageTable& page_table = process_page_tables.at(processId);
+    auto& pte = page_table[pageNumber];
+    int shared_frame = pte.frameNumber;
+
+    if (frame_table[shared_frame].sharers.empty()) {
+        // Nothing else maps this frame anymore, so it can be written in place.
+        if (shared_frame == zero_frame) zero_frame = -1;
+        pte.cow = false;
+        return true;
+    }
+
+    int words_per_frame = frameSize / sizeof(uint16_t);
+    auto shared_begin = physical_memory.begin() + (shared_frame * frameSize) / sizeof(uint16_t);
+    vector<uint16_t> contents(shared_begin, shared_begin + words_per_frame);
+
+    bool was_pinned = pte.pinned;
+    releaseMapping(shared_frame, processId, pageNumber);
+    pte.valid = false;
+    pte.frameNumber = -1;
+    pte.cow = false;
+
+    int target_frame = allocateFrame();
+    copy(contents.begin(), contents.end(), physical_memory.begin() + (target_frame * frameSize) / sizeof(uint16_t));
+
+    // A freshly loaded page starts with no sharers and no pins.
+    Frame& loaded = frame_table[target_frame];
+    loaded = Frame{};
+    loaded.allocated = true;
+    loaded.processId = processId;
+    loaded.pageNumber = pageNumber;
     pte.frameNumber = target_frame;
     pte.valid = true;
     pte.dirty = false;
+    if (page_table.faults) page_table.faults->minorFaults++;
+    minor_faults++;
+    if (was_pinned) {
+        pinFrame(target_frame);
+        pte.pinned = true;
+    }
+    pages_unmerged++;
+    return true;
+}
 
-    return target_frame;
+// Maps a page onto the shared all-zero frame as a copy-on-write page, if one exists.
+bool MemoryManager::mapZeroPage(const std::string& processId, int pageNumber) {
+    if (!merging_enabled || zero_frame == -1) return false;
+
+    frame_table[zero_frame].sharers.emplace_back(processId, pageNumber);
+    auto& pte = process_page_tables.at(processId)[pageNumber];
+    pte.frameNumber = zero_frame;
+    pte.valid = true;
+    pte.dirty = false;
+    pte.cow = true;
+
+    zero_page_maps++;
+    frames_saved++;
+    return true;
 }
 
-// Selects a victim frame to be replaced using a simple FIFO algorithm.
+// Selects a victim frame to be replaced using a simple FIFO algorithm, skipping pinned frames.
 int MemoryManager::findVictimFrame() {
     static int next_victim_frame = 0;
+    for (int attempts = 0; attempts < numFrames; ++attempts) {
+        int victim = next_victim_frame;
+        next_victim_frame = (next_victim_frame + 1) % numFrames;
+        if (frame_table[victim].pinCount == 0) return victim;
+    }
+
+    // Every frame is pinned; pins are only a residency hint, so fall back to plain FIFO.
     int victim = next_victim_frame;
     next_victim_frame = (next_victim_frame + 1) % numFrames;
     return victim;
 }
 
+// Pins the page holding address so it stays resident until unpinned.
+// If faultIn is false and the page is not resident, nothing is pinned and false is returned.
+bool MemoryManager::pinPage(const std::string& processId, uint16_t address, bool faultIn) {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    auto it = process_page_tables.find(processId);
+    if (it == process_page_tables.end()) return false;
+
+    int page_num = address / frameSize;
+    if (page_num >= static_cast<int>(it->second.size())) return false;
+
+    if (it->second[page_num].pinned) return true;
+    if (!it->second[page_num].valid) {
+        if (!faultIn || handlePageFault(processId, page_num) == -1) return false;
+    }
+
+    auto& pte = it->second[page_num];
+    pinFrame(pte.frameNumber);
+    pte.pinned = true;
+    return true;
+}
+
+// Releases the pin taken by pinPage, if the page still holds one.
+void MemoryManager::unpinPage(const std::string& processId, uint16_t address) {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    auto it = process_page_tables.find(processId);
+    if (it == process_page_tables.end()) return;
+
+    int page_num = address / frameSize;
+    if (page_num >= static_cast<int>(it->second.size())) return;
+
+    auto& pte = it->second[page_num];
+    if (pte.pinned && pte.valid) {
+        unpinFrame(pte.frameNumber);
+    }
+    pte.pinned = false;
+}
+
+// Adds a pin to a frame.
+void MemoryManager::pinFrame(int frameNumber) {
+    if (frame_table[frameNumber].pinCount++ == 0) pinned_frames++;
+}
+
+// Drops a pin from a frame.
+void MemoryManager::unpinFrame(int frameNumber) {
+    if (frame_table[frameNumber].pinCount > 0 && --frame_table[frameNumber].pinCount == 0) pinned_frames--;
+}
+
+// Returns the number of frames currently held resident by pins.
+int MemoryManager::getPinnedFrameCount() const {
+    return pinned_frames.load();
+}
+
 // Helper function to calculate a unique file offset for a page
 long long MemoryManager::getBackingStoreOffset(const std::string& processId, int pageNumber) const {
     long long pageSlot = 0;
@@ -188,7 +510,13 @@ void MemoryManager::writePageToBackingStore(int frameNumber) {
     const auto& frameInfo = frame_table[frameNumber];
     if (frameInfo.processId.empty()) return;
 
-    long long fileOffset = getBackingStoreOffset(frameInfo.processId, frameInfo.pageNumber);
+    int physical_address = (frameNumber * frameSize) / sizeof(uint16_t);
+    writePageToBackingStore(frameInfo.processId, frameInfo.pageNumber, &physical_memory[physical_address]);
+}
+
+// Writes one page worth of data to the page's slot in the backing store file.
+void MemoryManager::writePageToBackingStore(const std::string& processId, int pageNumber, const uint16_t* data) {
+    long long fileOffset = getBackingStoreOffset(processId, pageNumber);
     if (fileOffset == -1) return; // Process not found, cannot write
 
     // Use fstream for robust read/write operations
@@ -201,8 +529,7 @@ void MemoryManager::writePageToBackingStore(int frameNumber) {
     }
 
     file.seekp(fileOffset, ios::beg);
-    int physical_address = (frameNumber * frameSize) / sizeof(uint16_t);
-    file.write(reinterpret_cast<const char*>(&physical_memory[physical_address]), frameSize);
+    file.write(reinterpret_cast<const char*>(data), frameSize);
 }
 
 // Corrected function to read a page from its unique location
@@ -238,9 +565,14 @@ int MemoryManager::getTotalMemory() const {
     return totalMemory;
 }
 
-// Returns the current amount of used memory in bytes.
+// Returns the current amount of used memory in bytes, without taking the memory lock.
 int MemoryManager::getUsedMemory() const {
-    return (numFrames - static_cast<int>(free_frame_list.size())) * frameSize;
+    return used_frames.load(memory_order_relaxed) * frameSize;
+}
+
+// Returns the number of frames off the free list, without taking the memory lock.
+int MemoryManager::getUsedFrameCount() const {
+    return used_frames.load(memory_order_relaxed);
 }
 
 // Returns the memory usage for a single process.
@@ -267,18 +599,258 @@ int MemoryManager::getPagedOutCount() const {
     return pages_paged_out.load();
 }
 
+// Returns the number of frames folded into another identical frame.
+int MemoryManager::getPagesMergedCount() const {
+    return pages_merged.load();
+}
+
+// Returns the number of copy-on-write breaks that gave a page a private frame again.
+int MemoryManager::getPagesUnmergedCount() const {
+    return pages_unmerged.load();
+}
+
+// Returns the number of page faults served by mapping the shared zero frame.
+int MemoryManager::getZeroPageMapCount() const {
+    return zero_page_maps.load();
+}
+
+// Returns the number of frames currently saved by sharing.
+int MemoryManager::getFramesSaved() const {
+    return frames_saved.load();
+}
+
+// Places a compressed page pool of maxBytes between physical frames and the backing store file.
+void MemoryManager::enableCompressedSwap(size_t maxBytes) {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    if (maxBytes == 0 || compressed_pool) return;
+    compressed_pool = make_unique<CompressedSwapPool>(maxBytes,
+        [this](const std::string& processId, int pageNumber, const vector<uint16_t>& data) {
+            // Called from inside store() while memory_mutex_ is already held.
+            writePageToBackingStore(processId, pageNumber, data.data());
+        });
+}
+
+// Returns the compressed swap pool, or nullptr if the tier is disabled.
+const CompressedSwapPool* MemoryManager::getCompressedSwapPool() const {
+    return compressed_pool.get();
+}
+
+// Returns the number of page faults served from the compressed pool.
+int MemoryManager::getCompressedFaultCount() const {
+    return static_cast<int>(compressed_load_latency.getCount());
+}
+
+// Returns the average time to load a page from the compressed pool, in microseconds.
+double MemoryManager::getCompressedFaultAvgMicros() const {
+    return compressed_load_latency.getAverageNanos() / 1000.0;
+}
+
+// Returns the number of page faults served from the backing store file.
+int MemoryManager::getDiskFaultCount() const {
+    return static_cast<int>(backing_store_read_latency.getCount());
+}
+
+// Returns the average time to load a page from the backing store file, in microseconds.
+double MemoryManager::getDiskFaultAvgMicros() const {
+    return backing_store_read_latency.getAverageNanos() / 1000.0;
+}
+
+// Starts the background scanner that merges identical clean frames.
+void MemoryManager::startPageMerging(int scanIntervalMs) {
+    if (scanIntervalMs <= 0 || merging_enabled) return;
+    merging_enabled = true;
+    merge_thread = thread(&MemoryManager::pageMergeLoop, this, scanIntervalMs);
+}
+
+// Stops the page merging scanner and waits for it to exit.
+void MemoryManager::stopPageMerging() {
+    {
+        lock_guard<mutex> lock(merge_wait_mutex);
+        merging_enabled = false;
+    }
+    merge_wait_cv.notify_all();
+    if (merge_thread.joinable()) {
+        merge_thread.join();
+    }
+}
+
+// Returns true while the page merging scanner is running.
+bool MemoryManager::isPageMergingEnabled() const {
+    return merging_enabled.load();
+}
+
+// Scanner thread body: merges identical frames every scan interval until stopped.
+void MemoryManager::pageMergeLoop(int scanIntervalMs) {
+    while (merging_enabled) {
+        {
+            unique_lock<mutex> lock(merge_wait_mutex);
+            merge_wait_cv.wait_for(lock, chrono::milliseconds(scanIntervalMs), [this]() { return !merging_enabled; });
+        }
+        if (!merging_enabled) break;
+        scanForMergeablePages();
+    }
+}
+
+// Hashes clean frames and folds identical ones into a single shared copy-on-write frame.
+void MemoryManager::scanForMergeablePages() {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    unordered_map<uint64_t, int> frames_by_hash;
+
+    for (int frame_num = 0; frame_num < numFrames; ++frame_num) {
+        const auto& frame = frame_table[frame_num];
+        if (!frame.allocated || !process_page_tables.count(frame.processId)) continue;
+
+        // Dirty pages differ from their backing store copy and are left alone.
+        if (process_page_tables.at(frame.processId)[frame.pageNumber].dirty) continue;
+
+        uint64_t hash = hashFrame(frame_num);
+        auto candidate = frames_by_hash.find(hash);
+        if (candidate == frames_by_hash.end()) {
+            frames_by_hash.emplace(hash, frame_num);
+        }
+        else if (framesEqual(candidate->second, frame_num)) {
+            mergeFrames(candidate->second, frame_num);
+        }
+    }
+
+    // Remember an all-zero frame so fresh pages can map it without a frame of their own.
+    if (zero_frame == -1) {
+        for (const auto& entry : frames_by_hash) {
+            if (isZeroFrame(entry.second)) {
+                zero_frame = entry.second;
+                const auto& frame = frame_table[zero_frame];
+                process_page_tables.at(frame.processId)[frame.pageNumber].cow = true;
+                break;
+            }
+        }
+    }
+}
+
+// Moves every mapping of dropFrame onto the identical keepFrame and frees dropFrame.
+void MemoryManager::mergeFrames(int keepFrame, int dropFrame) {
+    auto& keep = frame_table[keepFrame];
+    auto& drop = frame_table[dropFrame];
+
+    process_page_tables.at(keep.processId)[keep.pageNumber].cow = true;
+
+    auto remap = [&](const std::string& processId, int pageNumber) {
+        auto& pte = process_page_tables.at(processId)[pageNumber];
+        pte.frameNumber = keepFrame;
+        pte.cow = true;
+        keep.sharers.emplace_back(processId, pageNumber);
+    };
+    remap(drop.processId, drop.pageNumber);
+    for (const auto& sharer : drop.sharers) {
+        remap(sharer.first, sharer.second);
+    }
+
+    // Pins follow the mappings onto the kept frame.
+    if (drop.pinCount > 0) {
+        if (keep.pinCount > 0) pinned_frames--;
+        keep.pinCount += drop.pinCount;
+    }
+
+    // Sharers of dropFrame were already counted as saved; only the dropped frame itself is new.
+    frames_saved++;
+    pages_merged++;
+
+    if (dropFrame == zero_frame) zero_frame = keepFrame;
+    drop = Frame{};
+    free_frame_list.push_back(dropFrame);
+    used_frames--;
+}
+
+// Computes an FNV-1a hash of a frame's contents.
+uint64_t MemoryManager::hashFrame(int frameNumber) const {
+    uint64_t hash = 14695981039346656037ULL;
+    int base = (frameNumber * frameSize) / sizeof(uint16_t);
+    int words_per_frame = frameSize / sizeof(uint16_t);
+    for (int i = 0; i < words_per_frame; ++i) {
+        hash ^= physical_memory[base + i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Compares the contents of two frames word by word.
+bool MemoryManager::framesEqual(int a, int b) const {
+    auto begin_a = physical_memory.begin() + (a * frameSize) / sizeof(uint16_t);
+    auto begin_b = physical_memory.begin() + (b * frameSize) / sizeof(uint16_t);
+    return equal(begin_a, begin_a + frameSize / sizeof(uint16_t), begin_b);
+}
+
+// Checks whether a frame holds only zeros.
+bool MemoryManager::isZeroFrame(int frameNumber) const {
+    auto begin = physical_memory.begin() + (frameNumber * frameSize) / sizeof(uint16_t);
+    return all_of(begin, begin + frameSize / sizeof(uint16_t), [](uint16_t word) { return word == 0; });
+}
+
+// Starts recording every readMemory/writeMemory to a binary trace file, replacing any active trace.
+bool MemoryManager::startTrace(const std::string& path, std::function<int()> tickSource) {
+    auto recorder = make_unique<MemoryTraceRecorder>(path, frameSize, numFrames, std::move(tickSource));
+    if (!recorder->isOpen()) return false;
+
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    trace_recorder = std::move(recorder);
+    return true;
+}
+
+// Stops tracing and flushes the trace file.
+void MemoryManager::stopTrace() {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    trace_recorder.reset();
+}
+
+// Returns true while accesses are being traced.
+bool MemoryManager::isTracing() const {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    return trace_recorder != nullptr;
+}
+
+// Returns the number of records written to the active trace.
+long long MemoryManager::getTraceRecordCount() const {
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
+    return trace_recorder ? trace_recorder->getRecordCount() : 0;
+}
+
+// Returns the total number of minor faults across all processes.
+int MemoryManager::getMinorFaultCount() const {
+    return minor_faults.load();
+}
+
+// Returns the total number of major faults across all processes.
+int MemoryManager::getMajorFaultCount() const {
+    return major_faults.load();
+}
+
+// Returns the latency histogram of whole page fault service, including eviction.
+const LatencyHistogram& MemoryManager::getFaultServiceLatency() const {
+    return fault_service_latency;
+}
+
+// Returns the latency histogram of dirty victim writeback.
+const LatencyHistogram& MemoryManager::getWritebackLatency() const {
+    return writeback_latency;
+}
+
+// Returns the latency histogram of page reads from the backing store file.
+const LatencyHistogram& MemoryManager::getBackingStoreReadLatency() const {
+    return backing_store_read_latency;
+}
+
 // Prints the current status of the frame table for debugging.
 void MemoryManager::printFrameTable() const {
-    lock_guard<std::mutex> lock(memory_mutex_);
+    lock_guard<ProfiledMutex> lock(memory_mutex_);
     cout << "--- Frame Table Status ---" << endl;
-    cout << "Frame | Allocated | Process ID | Page Num" << endl;
+    cout << "Frame | Allocated | Process ID | Page Num | Pins" << endl;
     cout << "--------------------------" << endl;
     for (int i = 0; i < numFrames; ++i) {
         const auto& frame = frame_table[i];
         cout << setw(5) << i << " | "
             << setw(9) << (frame.allocated ? "Yes" : "No") << " | "
             << setw(10) << (frame.allocated ? frame.processId : "N/A") << " | "
-            << setw(8) << (frame.allocated ? to_string(frame.pageNumber) : "N/A")
+            << setw(8) << (frame.allocated ? to_string(frame.pageNumber) : "N/A") << " | "
+            << setw(4) << frame.pinCount
             << endl;
     }
     cout << "Free frames left: " << free_frame_list.size() << endl;
@@ -5,6 +5,17 @@
 #include <unordered_map>
 #include <list>
 #include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <utility>
+#include <cstdint>
+#include "ProfiledMutex.h"
+#include <memory>
+#include <deque>
+#include <functional>
+#include "CompressedSwapPool.h"
+#include "LatencyHistogram.h"
+#include "MemoryTraceRecorder.h"
 using namespace std;
 
 // Represents a physical memory frame.
@@ -12,6 +23,9 @@ struct Frame {
     bool allocated = false;
     std::string processId;
     int pageNumber = -1;
+    // Extra (processId, pageNumber) mappings when this frame is a merged copy-on-write page.
+    std::vector<std::pair<std::string, int>> sharers;
+    int pinCount = 0; // pinned mappings; the replacement policy skips pinned frames
 };
 
 // Represents an entry in a process's page table.
@@ -19,9 +33,39 @@ struct PageTableEntry {
     int frameNumber = -1; // -1 if not in memory
     bool valid = false;
     bool dirty = false;
+    bool cow = false;     // true if the frame is shared and must be copied before a write
+    bool swapped = false; // true once the page has been written to the backing store
+    bool pinned = false;  // true while this mapping holds a pin on its frame
 };
 
-using PageTable = std::vector<PageTableEntry>;
+// Per-process page fault counters. Minor faults are served without I/O
+// (zero-page maps and copy-on-write breaks); major faults load the page
+// from the compressed pool or the backing store.
+struct ProcessFaultStats {
+    int minorFaults = 0;
+    int majorFaults = 0;
+};
+
+// Live fault counters of one process. The process owns them and its page table shares
+// them, so they are charged without a name lookup, survive deallocate(), and can be
+// read without memory_mutex_.
+struct ProcessFaultCounters {
+    std::atomic<int> minorFaults{ 0 };
+    std::atomic<int> majorFaults{ 0 };
+
+    ProcessFaultStats load() const {
+        ProcessFaultStats stats;
+        stats.minorFaults = minorFaults.load(std::memory_order_relaxed);
+        stats.majorFaults = majorFaults.load(std::memory_order_relaxed);
+        return stats;
+    }
+};
+
+// A process's page table, plus the counters its page faults are charged to.
+struct PageTable : std::vector<PageTableEntry> {
+    using std::vector<PageTableEntry>::vector;
+    std::shared_ptr<ProcessFaultCounters> faults; // null if nothing is counting
+};
 
 class MemoryManager {
 public:
@@ -32,33 +76,92 @@ public:
     static void destroy();
 
     // Memory Operations
-    bool setupProcessMemory(const std::string& processId, int size);
+    bool setupProcessMemory(const std::string& processId, int size, std::shared_ptr<ProcessFaultCounters> faults = nullptr);
     void deallocate(const std::string& processId);
 
 
     // Memory Access
     bool readMemory(const string& processId, uint16_t address, uint16_t& value);
 	bool writeMemory(const string& processId, uint16_t address, uint16_t value);
+
+    // Access Tracing
+    bool startTrace(const std::string& path, std::function<int()> tickSource);
+    void stopTrace();
+    bool isTracing() const;
+    long long getTraceRecordCount() const;
+
+    // Page Pinning
+    bool pinPage(const std::string& processId, uint16_t address, bool faultIn);
+    void unpinPage(const std::string& processId, uint16_t address);
+    int getPinnedFrameCount() const;
+
+    // Asynchronous Page-In
+    std::vector<int> getMissingPages(const std::string& processId, const std::vector<uint16_t>& addresses) const;
+    void requestPageIn(const std::string& processId, const std::vector<int>& pages, std::function<void()> onComplete);
+    void startPager();
+    void stopPager();
+    int getAsyncPageInCount() const;
     
     // Statistics
     int getTotalMemory() const;
     int getUsedMemory() const;
+    int getUsedFrameCount() const;
     int getProcessMemoryUsage(const std::string& processId) const;
     int getPagedInCount() const;
     int getPagedOutCount() const;
+    int getMinorFaultCount() const;
+    int getMajorFaultCount() const;
+    const LatencyHistogram& getFaultServiceLatency() const;
+    const LatencyHistogram& getWritebackLatency() const;
+    const LatencyHistogram& getBackingStoreReadLatency() const;
+
+    // Same-page merging
+    void startPageMerging(int scanIntervalMs);
+    void stopPageMerging();
+    bool isPageMergingEnabled() const;
+    int getPagesMergedCount() const;
+    int getPagesUnmergedCount() const;
+    int getZeroPageMapCount() const;
+    int getFramesSaved() const;
+
+    // Compressed swap tier
+    void enableCompressedSwap(size_t maxBytes);
+    const CompressedSwapPool* getCompressedSwapPool() const;
+    int getCompressedFaultCount() const;
+    double getCompressedFaultAvgMicros() const;
+    int getDiskFaultCount() const;
+    double getDiskFaultAvgMicros() const;
 
     void printFrameTable() const;
 
 private:
     MemoryManager(int totalMemory, int frameSize);
+    ~MemoryManager();
 
     long long getBackingStoreOffset(const std::string& processId, int pageNumber) const;
     // Page Fault and Backing Store Logic
     int handlePageFault(const std::string& processId, int pageNumber);
     int findVictimFrame();
     void writePageToBackingStore(int frameNumber);
+    void writePageToBackingStore(const std::string& processId, int pageNumber, const uint16_t* data);
     void readPageFromBackingStore(const std::string& processId, int pageNumber, int frameNumber);
 
+    // Frame Allocation and Sharing Helpers
+    int allocateFrame();
+    void evictFrame(int frameNumber);
+    void releaseMapping(int frameNumber, const std::string& processId, int pageNumber);
+    bool breakCopyOnWrite(const std::string& processId, int pageNumber);
+    bool mapZeroPage(const std::string& processId, int pageNumber);
+    bool isZeroFrame(int frameNumber) const;
+    uint64_t hashFrame(int frameNumber) const;
+    bool framesEqual(int a, int b) const;
+    void mergeFrames(int keepFrame, int dropFrame);
+    void pinFrame(int frameNumber);
+    void unpinFrame(int frameNumber);
+    void scanForMergeablePages();
+    void pageMergeLoop(int scanIntervalMs);
+    void pagerLoop();
+
     // Data Structures
     int totalMemory;
     int frameSize;
@@ -72,8 +175,48 @@ private:
     // Statistics Counter
     std::atomic<int> pages_paged_in{ 0 };
     std::atomic<int> pages_paged_out{ 0 };
+    std::atomic<int> pages_merged{ 0 };
+    std::atomic<int> pages_unmerged{ 0 };
+    std::atomic<int> zero_page_maps{ 0 };
+    std::atomic<int> frames_saved{ 0 };
+    std::atomic<int> pinned_frames{ 0 };
+    std::atomic<int> used_frames{ 0 }; // frames off the free list, kept beside it for lock-free readers
+
+    // Fault accounting and latency histograms
+    std::atomic<int> minor_faults{ 0 };
+    std::atomic<int> major_faults{ 0 };
+    LatencyHistogram fault_service_latency;
+    LatencyHistogram writeback_latency;
+    LatencyHistogram backing_store_read_latency;
+    LatencyHistogram compressed_load_latency;
+
+    // Compressed swap tier
+    std::unique_ptr<CompressedSwapPool> compressed_pool;
+
+    // Optional access trace, recorded under memory_mutex_
+    std::unique_ptr<MemoryTraceRecorder> trace_recorder;
+
+    // Pager thread that services page-in requests for blocked processes
+    struct PageInRequest {
+        std::string processId;
+        std::vector<int> pages;
+        std::function<void()> onComplete;
+    };
+    std::thread pager_thread;
+    std::deque<PageInRequest> pager_queue;
+    std::mutex pager_mutex;
+    std::condition_variable pager_cv;
+    bool pager_running = false;
+    std::atomic<int> async_page_ins{ 0 };
+
+    // Same-page merging scanner
+    int zero_frame = -1; // shared all-zero frame, -1 if none
+    std::thread merge_thread;
+    std::atomic<bool> merging_enabled{ false };
+    std::mutex merge_wait_mutex;
+    std::condition_variable merge_wait_cv;
 
-    mutable std::mutex memory_mutex_;
+    mutable ProfiledMutex memory_mutex_{ "MemoryManager::memory_mutex_" };
     static MemoryManager* instance;
     static std::mutex mutex_;
 };
\ No newline at end of file
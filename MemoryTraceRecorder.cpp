@@ -0,0 +1,55 @@
+#include "MemoryTraceRecorder.h"
+#include <cstring>
+using namespace std;
+
+// Constructor: opens the trace file and writes its header.
+MemoryTraceRecorder::MemoryTraceRecorder(const string& path, int frameSize, int numFrames, function<int()> tickSource)
+    : path(path), file(path, ios::binary | ios::trunc), tickSource(std::move(tickSource)) {
+    buffer.reserve(FLUSH_THRESHOLD);
+    if (!file) return;
+
+    TraceFileHeader header;
+    memcpy(header.magic, "CSMT", 4);
+    header.version = FORMAT_VERSION;
+    header.frameSize = static_cast<uint32_t>(frameSize);
+    header.numFrames = static_cast<uint32_t>(numFrames);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+// Destructor: writes out any buffered records.
+MemoryTraceRecorder::~MemoryTraceRecorder() {
+    flush();
+}
+
+// Returns true if the trace file could be opened.
+bool MemoryTraceRecorder::isOpen() const {
+    return file.is_open() && file.good();
+}
+
+// Appends one record to the buffer, writing the buffer out when it fills.
+void MemoryTraceRecorder::record(const string& processId, int pageNumber, TraceAccessKind kind) {
+    auto it = processIds.find(processId);
+    if (it == processIds.end()) {
+        it = processIds.emplace(processId, static_cast<uint32_t>(processIds.size())).first;
+    }
+
+    TraceRecord entry;
+    entry.tick = static_cast<uint32_t>(tickSource ? tickSource() : 0);
+    entry.processId = it->second;
+    entry.pageAndKind = (static_cast<uint32_t>(pageNumber) << 2) | static_cast<uint32_t>(kind);
+    buffer.push_back(entry);
+    recordCount++;
+
+    if (buffer.size() >= FLUSH_THRESHOLD) flush();
+}
+
+// Writes all buffered records to the file.
+void MemoryTraceRecorder::flush() {
+    if (buffer.empty() || !file) return;
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(TraceRecord));
+    file.flush();
+    buffer.clear();
+}
+
+long long MemoryTraceRecorder::getRecordCount() const { return recordCount; }
+string MemoryTraceRecorder::getPath() const { return path; }
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include <functional>
+
+// On-disk layout of a memory access trace: one TraceFileHeader followed by TraceRecords.
+// Shared by the recorder and the offline replay tool (tools/TraceReplay.cpp).
+struct TraceFileHeader {
+    char magic[4];      // "CSMT"
+    uint32_t version;
+    uint32_t frameSize; // mem-per-frame of the recorded run
+    uint32_t numFrames; // physical frames of the recorded run
+};
+
+enum class TraceAccessKind : uint32_t {
+    READ = 0,
+    WRITE = 1,
+    RELEASE = 2 // the process exited and all its pages were released
+};
+
+struct TraceRecord {
+    uint32_t tick;        // scheduler CPU tick at the time of the access
+    uint32_t processId;   // dense id assigned in order of first appearance
+    uint32_t pageAndKind; // page number << 2 | TraceAccessKind
+
+    uint32_t page() const { return pageAndKind >> 2; }
+    TraceAccessKind kind() const { return static_cast<TraceAccessKind>(pageAndKind & 0x3); }
+};
+static_assert(sizeof(TraceRecord) == 12, "TraceRecord must stay packed for the on-disk format");
+
+// Buffers memory access records and appends them to a binary trace file.
+// Not internally synchronized; callers must hold the memory manager's lock.
+class MemoryTraceRecorder {
+public:
+    static const uint32_t FORMAT_VERSION = 1;
+
+    MemoryTraceRecorder(const std::string& path, int frameSize, int numFrames, std::function<int()> tickSource);
+    ~MemoryTraceRecorder();
+
+    bool isOpen() const;
+    void record(const std::string& processId, int pageNumber, TraceAccessKind kind);
+    void flush();
+    long long getRecordCount() const;
+    std::string getPath() const;
+
+private:
+    static const size_t FLUSH_THRESHOLD = 4096;
+
+    std::string path;
+    std::ofstream file;
+    std::function<int()> tickSource;
+    std::vector<TraceRecord> buffer;
+    std::unordered_map<std::string, uint32_t> processIds;
+    long long recordCount = 0;
+};
@@ -0,0 +1,245 @@
+#include "MetricsExporter.h"
+#include "Scheduler.h"
+#include "ScreenManager.h"
+#include "MemoryManager.h"
+#include "CompressedSwapPool.h"
+#include "Clock.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+const char* MetricsExporter::PROMETHEUS_PATH = "csopesy-metrics.prom";
+const char* MetricsExporter::JSON_PATH = "csopesy-metrics.json";
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+void MetricsExporter::setIntervalTicks(int ticks) { intervalTicks = max(0, ticks); }
+int MetricsExporter::getIntervalTicks() const { return intervalTicks; }
+
+void MetricsExporter::start() {
+    lock_guard<mutex> lock(queueMutex);
+    if (running || intervalTicks == 0) return;
+    running = true;
+    worker = thread(&MetricsExporter::run, this);
+}
+
+void MetricsExporter::stop() {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        if (!running) return;
+        running = false;
+    }
+    queueCondition.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+// Called by the tick thread; queues an export every intervalTicks ticks.
+void MetricsExporter::onTick(int tick) {
+    if (intervalTicks == 0 || tick % intervalTicks != 0) return;
+    {
+        lock_guard<mutex> lock(queueMutex);
+        if (!running) return;
+        requested++;
+    }
+    queueCondition.notify_one();
+}
+
+long long MetricsExporter::getExportsWritten() const {
+    lock_guard<mutex> lock(queueMutex);
+    return exportsWritten;
+}
+
+// Exports until stopped; requests that pile up during an export are served by the next one.
+void MetricsExporter::run() {
+    unique_lock<mutex> lock(queueMutex);
+    while (true) {
+        queueCondition.wait(lock, [this]() { return written < requested || !running; });
+        if (!running) break;
+        long long target = requested;
+        lock.unlock();
+
+        vector<MetricSample> samples = collect();
+        stringstream prometheus, json;
+        writePrometheus(prometheus, samples);
+        writeJson(json, samples);
+        bool ok = writeFile(PROMETHEUS_PATH, prometheus.str()) && writeFile(JSON_PATH, json.str());
+        if (!ok) cerr << "Failed to write metrics to '" << PROMETHEUS_PATH << "' / '" << JSON_PATH << "'." << endl;
+
+        lock.lock();
+        written = target;
+        if (ok) exportsWritten++;
+    }
+}
+
+// Replaces a file through a temporary file, so readers see the old or the new contents.
+bool MetricsExporter::writeFile(const string& path, const string& contents) {
+    string temporaryPath = path + ".tmp";
+    {
+        ofstream out(temporaryPath, ios::out | ios::trunc | ios::binary);
+        if (!out) return false;
+        out << contents;
+        out.flush();
+        if (!out) return false;
+    }
+    remove(path.c_str());
+    return rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+// Gathers every exported value. Scheduler and memory figures are atomics; the
+// per-process ones come from one registry snapshot, which only takes the shard locks.
+vector<MetricSample> MetricsExporter::collect() {
+    vector<MetricSample> samples;
+    Scheduler* scheduler = Scheduler::getInstance();
+    MemoryManager* memManager = MemoryManager::getInstance();
+    ScreenManager* screenManager = ScreenManager::getInstance();
+    if (!scheduler || !screenManager) return samples;
+
+    samples.push_back({ "csopesy_ticks_total", "CPU ticks since initialize.", "counter", {}, static_cast<double>(scheduler->getCpuCycles()) });
+    samples.push_back({ "csopesy_instructions_total", "Instructions executed by all cores.", "counter", {}, static_cast<double>(scheduler->getInstructionsExecuted()) });
+    samples.push_back({ "csopesy_cores", "Configured CPU cores.", "gauge", {}, static_cast<double>(scheduler->getNumCores()) });
+    samples.push_back({ "csopesy_cores_busy", "Cores running a process.", "gauge", {}, static_cast<double>(scheduler->getUsedCores()) });
+    vector<CoreStats> cores;
+    for (int i = 0; i < scheduler->getNumCores(); ++i) cores.push_back(scheduler->getCoreStats(i));
+    auto perCore = [&](const char* name, const char* help, auto value) {
+        for (size_t i = 0; i < cores.size(); ++i) {
+            samples.push_back({ name, help, "counter", { { "core", to_string(i) } }, static_cast<double>(value(cores[i])) });
+        }
+    };
+    perCore("csopesy_core_busy_ticks_total", "Ticks a core spent running a process.", [](const CoreStats& core) { return core.busyTicks; });
+    perCore("csopesy_core_idle_ticks_total", "Ticks a core spent idle.", [](const CoreStats& core) { return core.idleTicks; });
+    perCore("csopesy_core_instructions_total", "Instructions retired on a core.", [](const CoreStats& core) { return core.instructions; });
+
+    static const pair<ProcessState, const char*> states[] = {
+        { ProcessState::READY, "ready" }, { ProcessState::RUNNING, "running" }, { ProcessState::BLOCKED, "blocked" },
+        { ProcessState::FINISHED, "finished" }, { ProcessState::VIOLATED, "violated" }
+    };
+    for (const auto& [state, name] : states) {
+        samples.push_back({ "csopesy_processes", "Processes by state.", "gauge", { { "state", name } }, static_cast<double>(screenManager->getProcessCount(state)) });
+    }
+    samples.push_back({ "csopesy_processes_archived_total", "Finished processes moved to the archive.", "counter", {}, static_cast<double>(screenManager->getArchive().getArchivedCount()) });
+    samples.push_back({ "csopesy_reports_written_total", "Reports written by report-util.", "counter", {}, static_cast<double>(scheduler->getReporter().getReportsWritten()) });
+
+    if (memManager) {
+        samples.push_back({ "csopesy_memory_bytes", "Configured physical memory.", "gauge", {}, static_cast<double>(memManager->getTotalMemory()) });
+        samples.push_back({ "csopesy_memory_used_bytes", "Physical memory in use.", "gauge", {}, static_cast<double>(memManager->getUsedMemory()) });
+        samples.push_back({ "csopesy_frames_used", "Frames off the free list.", "gauge", {}, static_cast<double>(memManager->getUsedFrameCount()) });
+        samples.push_back({ "csopesy_frames_pinned", "Frames pinned by running processes.", "gauge", {}, static_cast<double>(memManager->getPinnedFrameCount()) });
+        samples.push_back({ "csopesy_pages_paged_in_total", "Pages loaded into a frame.", "counter", {}, static_cast<double>(memManager->getPagedInCount()) });
+        samples.push_back({ "csopesy_pages_paged_out_total", "Pages written to the backing store.", "counter", {}, static_cast<double>(memManager->getPagedOutCount()) });
+        samples.push_back({ "csopesy_page_faults_total", "Page faults by kind.", "counter", { { "kind", "minor" } }, static_cast<double>(memManager->getMinorFaultCount()) });
+        samples.push_back({ "csopesy_page_faults_total", "Page faults by kind.", "counter", { { "kind", "major" } }, static_cast<double>(memManager->getMajorFaultCount()) });
+        samples.push_back({ "csopesy_async_page_ins_total", "Page-ins served by the pager thread.", "counter", {}, static_cast<double>(memManager->getAsyncPageInCount()) });
+        samples.push_back({ "csopesy_pages_merged_total", "Frames folded into an identical frame.", "counter", {}, static_cast<double>(memManager->getPagesMergedCount()) });
+        samples.push_back({ "csopesy_pages_unmerged_total", "Copy-on-write breaks of merged pages.", "counter", {}, static_cast<double>(memManager->getPagesUnmergedCount()) });
+        samples.push_back({ "csopesy_zero_page_maps_total", "Faults served by the shared zero frame.", "counter", {}, static_cast<double>(memManager->getZeroPageMapCount()) });
+        samples.push_back({ "csopesy_frames_saved", "Frames currently saved by sharing.", "gauge", {}, static_cast<double>(memManager->getFramesSaved()) });
+
+        const pair<const char*, const LatencyHistogram*> latencies[] = {
+            { "fault_service", &memManager->getFaultServiceLatency() }, { "writeback", &memManager->getWritebackLatency() },
+            { "backing_store_read", &memManager->getBackingStoreReadLatency() }
+        };
+        for (const auto& [operation, histogram] : latencies) {
+            samples.push_back({ "csopesy_latency_count", "Timed memory operations.", "counter", { { "operation", operation } }, static_cast<double>(histogram->getCount()) });
+        }
+        for (const auto& [operation, histogram] : latencies) {
+            samples.push_back({ "csopesy_latency_average_seconds", "Average latency of a memory operation.", "gauge", { { "operation", operation } }, histogram->getAverageNanos() / 1e9 });
+        }
+        for (const auto& [operation, histogram] : latencies) {
+            samples.push_back({ "csopesy_latency_max_seconds", "Maximum latency of a memory operation.", "gauge", { { "operation", operation } }, histogram->getMaxNanos() / 1e9 });
+        }
+        samples.push_back({ "csopesy_swap_faults_total", "Page faults served from a swap tier.", "counter", { { "tier", "compressed" } }, static_cast<double>(memManager->getCompressedFaultCount()) });
+        samples.push_back({ "csopesy_swap_faults_total", "Page faults served from a swap tier.", "counter", { { "tier", "disk" } }, static_cast<double>(memManager->getDiskFaultCount()) });
+        if (const CompressedSwapPool* pool = memManager->getCompressedSwapPool()) {
+            samples.push_back({ "csopesy_compressed_pool_bytes", "Bytes held by the compressed swap pool.", "gauge", {}, static_cast<double>(pool->getUsedBytes()) });
+            samples.push_back({ "csopesy_compressed_pool_pages", "Pages held by the compressed swap pool.", "gauge", {}, static_cast<double>(pool->getStoredPageCount()) });
+        }
+    }
+
+    // Per-process values, grouped by metric so each family is contiguous.
+    ProcessRegistry::Snapshot processes = screenManager->snapshotProcesses();
+    vector<pair<vector<pair<string, string>>, ProcessMetrics>> rows;
+    vector<pair<int, int>> progress; // (instruction, instructions)
+    vector<ProcessFaultStats> faults;
+    for (const auto* list : { &processes.active, &processes.finished }) {
+        for (const auto& screen : *list) {
+            rows.push_back({ { { "process", screen->getName() }, { "state", screen->getStateName() } }, screen->getMetrics() });
+            progress.push_back({ screen->getProgramCounter(), screen->getTotalInstructions() });
+            faults.push_back(screen->getFaultStats());
+        }
+    }
+    auto perProcess = [&](const char* name, const char* help, const char* type, auto value) {
+        for (size_t i = 0; i < rows.size(); ++i) {
+            samples.push_back({ name, help, type, rows[i].first, static_cast<double>(value(i)) });
+        }
+    };
+    perProcess("csopesy_process_instruction", "Instructions a process has executed.", "gauge", [&](size_t i) { return progress[i].first; });
+    perProcess("csopesy_process_instructions", "Instructions in a process's program.", "gauge", [&](size_t i) { return progress[i].second; });
+    perProcess("csopesy_process_cpu_ticks", "Ticks a process has held a core.", "gauge", [&](size_t i) { return rows[i].second.cpuTicks; });
+    perProcess("csopesy_process_ready_wait_ticks", "Ticks a process has waited in the ready queue.", "gauge", [&](size_t i) { return rows[i].second.readyWaitTicks; });
+    perProcess("csopesy_process_blocked_ticks", "Ticks a process has been parked on page faults.", "gauge", [&](size_t i) { return rows[i].second.blockedTicks; });
+    perProcess("csopesy_process_dispatches", "Times a process has been dispatched to a core.", "gauge", [&](size_t i) { return rows[i].second.dispatchCount; });
+    for (size_t i = 0; i < rows.size(); ++i) {
+        for (const auto& kind : { make_pair("minor", faults[i].minorFaults), make_pair("major", faults[i].majorFaults) }) {
+            vector<pair<string, string>> labels = rows[i].first;
+            labels.push_back({ "kind", kind.first });
+            samples.push_back({ "csopesy_process_page_faults_total", "Page faults a process has taken, by kind.", "counter", labels, static_cast<double>(kind.second) });
+        }
+    }
+    return samples;
+}
+
+// Escapes a label value for the Prometheus and JSON string syntax, which agree on these.
+static string escapeLabel(const string& value) {
+    string escaped;
+    for (char c : value) {
+        if (c == '\\' || c == '"') escaped += '\\';
+        if (c == '\n') { escaped += "\\n"; continue; }
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Writes the Prometheus text exposition format; HELP and TYPE precede each family.
+void MetricsExporter::writePrometheus(ostream& out, const vector<MetricSample>& samples) {
+    streamsize precision = out.precision(12);
+    const char* family = nullptr;
+    for (const MetricSample& sample : samples) {
+        if (!family || string(family) != sample.name) {
+            family = sample.name;
+            out << "# HELP " << sample.name << " " << sample.help << "\n";
+            out << "# TYPE " << sample.name << " " << sample.type << "\n";
+        }
+        out << sample.name;
+        if (!sample.labels.empty()) {
+            out << "{";
+            for (size_t i = 0; i < sample.labels.size(); ++i) {
+                out << (i ? "," : "") << sample.labels[i].first << "=\"" << escapeLabel(sample.labels[i].second) << "\"";
+            }
+            out << "}";
+        }
+        out << " " << sample.value << "\n";
+    }
+    out.precision(precision);
+}
+
+// Writes the same samples as one JSON document.
+void MetricsExporter::writeJson(ostream& out, const vector<MetricSample>& samples) {
+    streamsize precision = out.precision(12);
+    out << "{\n  \"time\": " << static_cast<long long>(Clock::wallTime()) << ",\n  \"metrics\": [";
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const MetricSample& sample = samples[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": \"" << sample.name << "\", \"type\": \"" << sample.type << "\", \"labels\": {";
+        for (size_t j = 0; j < sample.labels.size(); ++j) {
+            out << (j ? ", " : "") << "\"" << sample.labels[j].first << "\": \"" << escapeLabel(sample.labels[j].second) << "\"";
+        }
+        out << "}, \"value\": " << sample.value << "}";
+    }
+    out << "\n  ]\n}\n";
+    out.precision(precision);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// One exported value: a metric name, its labels and the value at collection time.
+struct MetricSample {
+    const char* name;
+    const char* help;
+    const char* type; // "counter" or "gauge"
+    std::vector<std::pair<std::string, std::string>> labels;
+    double value;
+};
+
+// Publishes the Scheduler, MemoryManager and per-process counters for scripts and
+// monitoring, in Prometheus text format and as JSON. Every N ticks its own thread
+// rewrites csopesy-metrics.prom and csopesy-metrics.json, each through a temporary file
+// renamed into place so a scraper never reads a half-written file. Collection reads only
+// atomic counters and one registry snapshot; it never takes the memory manager or
+// ready queue locks.
+class MetricsExporter {
+public:
+    ~MetricsExporter();
+
+    // Configuration (metrics-interval-ticks)
+    void setIntervalTicks(int ticks);
+    int getIntervalTicks() const;
+    static const char* PROMETHEUS_PATH;
+    static const char* JSON_PATH;
+
+    // Thread Control
+    void start();
+    void stop();
+
+    // Triggers
+    void onTick(int tick);
+
+    // Collection and Formatting
+    static std::vector<MetricSample> collect();
+    static void writePrometheus(std::ostream& out, const std::vector<MetricSample>& samples);
+    static void writeJson(std::ostream& out, const std::vector<MetricSample>& samples);
+
+    // Statistics
+    long long getExportsWritten() const;
+
+private:
+    void run();
+    static bool writeFile(const std::string& path, const std::string& contents);
+
+    int intervalTicks = 0; // 0 = no file export
+
+    std::thread worker;
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    long long requested = 0;
+    long long written = 0;
+    long long exportsWritten = 0;
+    bool running = false;
+};
@@ -0,0 +1,75 @@
+#include "PrintLog.h"
+#include "Clock.h"
+using namespace std;
+
+size_t PrintLog::defaultCapacity = 4096;
+
+void PrintLog::setDefaultCapacity(size_t value) {
+    defaultCapacity = value > 0 ? value : 1;
+}
+
+size_t PrintLog::getDefaultCapacity() {
+    return defaultCapacity;
+}
+
+PrintLog::PrintLog() : capacity(defaultCapacity) {}
+
+// Stores a record, overwriting the oldest one if the ring is full. The storage grows
+// with the log, so a process that prints little never allocates the full capacity.
+void PrintLog::append(const Record& record) {
+    if (records.size() < capacity) {
+        records.push_back(record);
+        return;
+    }
+    records[head] = record;
+    head = (head + 1) % capacity;
+    dropped++;
+}
+
+void PrintLog::clear() {
+    vector<Record>().swap(records);
+    head = 0;
+}
+
+// Returns the records in the order they were written.
+vector<PrintLog::Record> PrintLog::snapshot() const {
+    vector<Record> ordered;
+    ordered.reserve(records.size());
+    ordered.insert(ordered.end(), records.begin() + head, records.end());
+    ordered.insert(ordered.end(), records.begin(), records.begin() + head);
+    return ordered;
+}
+
+size_t PrintLog::size() const {
+    return records.size();
+}
+
+long long PrintLog::getDroppedCount() const {
+    return dropped;
+}
+
+// Checks whether the message of a PRINT contains the %var% placeholder of its operand.
+bool PrintLog::hasPlaceholder(const Instruction& print) {
+    if (print.operands.empty() || !print.operands[0].isVariable) return false;
+    const string& message = print.printMessage;
+    const string& variable = print.operands[0].variableName;
+    for (size_t pos = message.find('%'); pos != string::npos; pos = message.find('%', pos + 1)) {
+        size_t end = pos + 1 + variable.size();
+        if (end < message.size() && message[end] == '%' && message.compare(pos + 1, variable.size(), variable) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Formats a record as the log line shown by process-smi:
+// (<timestamp>) Core:<core> "<message with %var% replaced>"
+string PrintLog::format(const Record& record) {
+    string output = record.message->printMessage;
+    if (hasPlaceholder(*record.message)) {
+        string placeholder = "%" + record.message->operands[0].variableName + "%";
+        size_t pos = output.find(placeholder);
+        output.replace(pos, placeholder.length(), to_string(record.value));
+    }
+    return "(" + Clock::format(record.wallTime) + ") Core:" + to_string(record.core) + " \"" + output + "\"";
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Instruction.h"
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// Bounded log of the PRINT instructions a process executed, kept as fixed-size binary
+// records and formatted only when displayed. When the ring is full the oldest record is
+// overwritten and counted as dropped. Not synchronized; Screen guards it with outputMutex.
+class PrintLog {
+public:
+    struct Record {
+        const Instruction* message; // the PRINT executed; owns the message and placeholder name
+        std::time_t wallTime;
+        int32_t tick;
+        uint16_t value;             // value substituted for the %var% placeholder, if any
+        int16_t core;
+    };
+
+    // Capacity of logs created from now on, in records (configured by print-log-capacity).
+    static void setDefaultCapacity(size_t capacity);
+    static size_t getDefaultCapacity();
+
+    PrintLog();
+
+    // Recording
+    void append(const Record& record);
+    void clear(); // drops every record and frees the storage
+
+    // Reading
+    std::vector<Record> snapshot() const; // oldest first
+    size_t size() const;
+    long long getDroppedCount() const;
+
+    // Formatting
+    static bool hasPlaceholder(const Instruction& print);
+    static std::string format(const Record& record);
+
+private:
+    std::vector<Record> records;
+    size_t capacity;
+    size_t head = 0; // next slot to overwrite once the ring is full
+    long long dropped = 0;
+    static size_t defaultCapacity;
+};
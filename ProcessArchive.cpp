@@ -0,0 +1,89 @@
+#include "ProcessArchive.h"
+using namespace std;
+
+ProcessArchive::~ProcessArchive() {
+    close();
+}
+
+// Creates (or truncates) the archive file and clears the index.
+bool ProcessArchive::open(const string& filePath) {
+    lock_guard<mutex> lock(fileMutex);
+    if (out.is_open()) out.close();
+    path = filePath;
+    index.clear();
+    archivedCount = 0;
+    bytesWritten = 0;
+    out.open(path, ios::out | ios::trunc | ios::binary);
+    return out.is_open();
+}
+
+void ProcessArchive::close() {
+    lock_guard<mutex> lock(fileMutex);
+    if (out.is_open()) out.close();
+}
+
+bool ProcessArchive::isOpen() const {
+    lock_guard<mutex> lock(fileMutex);
+    return out.is_open();
+}
+
+// Appends a process's log and indexes it by name. A process archived twice keeps its latest log.
+bool ProcessArchive::append(const string& name, const vector<string>& lines) {
+    lock_guard<mutex> lock(fileMutex);
+    if (!out.is_open()) return false;
+
+    string header = "== " + name + " " + to_string(lines.size()) + "\n";
+    long long offset = bytesWritten.load() + static_cast<long long>(header.size());
+    long long bytes = 0;
+    out << header;
+    for (const auto& line : lines) {
+        out << line << '\n';
+        bytes += static_cast<long long>(line.size()) + 1;
+    }
+    // Flushed so read() can open the file independently and see the whole log.
+    out.flush();
+    if (!out) return false;
+
+    index[name] = IndexEntry{ offset, bytes, static_cast<int>(lines.size()) };
+    bytesWritten += static_cast<long long>(header.size()) + bytes;
+    archivedCount++;
+    return true;
+}
+
+// Reads an archived log back from the file. Returns no lines for an unknown name.
+vector<string> ProcessArchive::read(const string& name) const {
+    IndexEntry entry;
+    string filePath;
+    {
+        lock_guard<mutex> lock(fileMutex);
+        auto it = index.find(name);
+        if (it == index.end()) return {};
+        entry = it->second;
+        filePath = path;
+    }
+
+    vector<string> lines;
+    lines.reserve(entry.lines);
+    ifstream in(filePath, ios::binary);
+    if (!in) return lines;
+    in.seekg(entry.offset);
+    string buffer(static_cast<size_t>(entry.bytes), '\0');
+    in.read(buffer.data(), entry.bytes);
+
+    size_t start = 0;
+    for (int i = 0; i < entry.lines; ++i) {
+        size_t end = buffer.find('\n', start);
+        if (end == string::npos) break;
+        lines.push_back(buffer.substr(start, end - start));
+        start = end + 1;
+    }
+    return lines;
+}
+
+long long ProcessArchive::getArchivedCount() const {
+    return archivedCount.load();
+}
+
+long long ProcessArchive::getBytesWritten() const {
+    return bytesWritten.load();
+}
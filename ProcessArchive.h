@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Append-only file holding the PRINT logs of archived (finished) processes, with an
+// in-memory index from process name to the log's byte range so it can be read back.
+// Each log is written as a "== <name> <lines>" header followed by one line per entry.
+class ProcessArchive {
+public:
+    ~ProcessArchive();
+
+    // File Control
+    bool open(const std::string& path); // truncates the file
+    void close();
+    bool isOpen() const;
+
+    // Archiving
+    bool append(const std::string& name, const std::vector<std::string>& lines);
+    std::vector<std::string> read(const std::string& name) const;
+
+    // Statistics
+    long long getArchivedCount() const;
+    long long getBytesWritten() const;
+
+private:
+    struct IndexEntry {
+        long long offset; // first byte after the header line
+        long long bytes;
+        int lines;
+    };
+
+    mutable std::mutex fileMutex;
+    std::string path;
+    std::ofstream out;
+    std::unordered_map<std::string, IndexEntry> index;
+    std::atomic<long long> archivedCount{ 0 };
+    std::atomic<long long> bytesWritten{ 0 };
+};
@@ -0,0 +1,65 @@
+#include "ProcessProfile.h"
+#include <sstream>
+#include <iomanip>
+using namespace std;
+
+std::atomic<bool> ProcessProfile::enabled{ false };
+
+void ProcessProfile::setEnabled(bool value) {
+    enabled.store(value);
+}
+
+// Counts one execution of an instruction and the pages it had to fault in.
+void ProcessProfile::recordExecution(const Instruction* site, int faultedPages) {
+    lock_guard<mutex> lock(countsMutex);
+    SiteCounts& site_counts = counts[site];
+    site_counts.executions++;
+    site_counts.faults += faultedPages;
+}
+
+// Charges ticks that passed while the instruction was executing.
+void ProcessProfile::recordSamples(const Instruction* site, int ticks) {
+    lock_guard<mutex> lock(countsMutex);
+    counts[site].samples += ticks;
+}
+
+// Returns a copy of the counts of every instruction executed so far.
+unordered_map<const Instruction*, ProcessProfile::SiteCounts> ProcessProfile::getCounts() const {
+    lock_guard<mutex> lock(countsMutex);
+    return counts;
+}
+
+// Formats an instruction as a short line of source, e.g. "READ var_1 0x1A0" or "FOR x3".
+string ProcessProfile::describe(const Instruction& instruction) {
+    auto operand = [](const Operand& op) { return op.isVariable ? op.variableName : to_string(op.value); };
+    stringstream ss;
+    switch (instruction.type) {
+    case InstructionType::PRINT:
+        ss << "PRINT \"" << instruction.printMessage << "\"";
+        break;
+    case InstructionType::DECLARE:
+        ss << "DECLARE " << operand(instruction.operands[0]) << " " << operand(instruction.operands[1]);
+        break;
+    case InstructionType::ADD:
+    case InstructionType::SUBTRACT:
+        ss << (instruction.type == InstructionType::ADD ? "ADD " : "SUBTRACT ")
+            << operand(instruction.operands[0]) << " " << operand(instruction.operands[1]) << " " << operand(instruction.operands[2]);
+        break;
+    case InstructionType::SLEEP:
+        ss << "SLEEP " << operand(instruction.operands[0]);
+        break;
+    case InstructionType::FOR:
+        ss << "FOR x" << operand(instruction.operands[0]);
+        break;
+    case InstructionType::READ:
+        ss << "READ " << operand(instruction.operands[0]) << " 0x" << hex << uppercase << instruction.memoryAddress;
+        break;
+    case InstructionType::WRITE:
+        ss << "WRITE 0x" << hex << uppercase << instruction.memoryAddress << dec << " " << operand(instruction.operands[0]);
+        break;
+    default:
+        ss << "?";
+        break;
+    }
+    return ss.str();
+}
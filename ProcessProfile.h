@@ -0,0 +1,36 @@
+#pragma once
+#include "Instruction.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Exact execution counts, page-fault counts and tick samples for each instruction of
+// one process. Instructions are keyed by address, which is stable because a Screen
+// never changes its program after construction. Written by the core running the
+// process and read by the display commands.
+class ProcessProfile {
+public:
+    struct SiteCounts {
+        long long executions = 0;
+        long long faults = 0;  // non-resident pages the instruction touched
+        long long samples = 0; // ticks that passed while the instruction was executing
+    };
+
+    // Profiling Control
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    // Recording
+    void recordExecution(const Instruction* site, int faultedPages);
+    void recordSamples(const Instruction* site, int ticks);
+
+    // Reporting
+    std::unordered_map<const Instruction*, SiteCounts> getCounts() const;
+    static std::string describe(const Instruction& instruction);
+
+private:
+    mutable std::mutex countsMutex;
+    std::unordered_map<const Instruction*, SiteCounts> counts;
+    static std::atomic<bool> enabled;
+};
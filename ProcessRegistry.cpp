@@ -0,0 +1,160 @@
+#include "ProcessRegistry.h"
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <utility>
+using namespace std;
+
+ProcessRegistry::Shard& ProcessRegistry::shardFor(const string& name) {
+    return shards[hash<string>{}(name) % SHARD_COUNT];
+}
+
+const ProcessRegistry::Shard& ProcessRegistry::shardFor(const string& name) const {
+    return shards[hash<string>{}(name) % SHARD_COUNT];
+}
+
+bool ProcessRegistry::isFinishedState(ProcessState state) {
+    return state == ProcessState::FINISHED || state == ProcessState::VIOLATED;
+}
+
+// Registers a screen in the given state (NEW for a process), replacing any screen with the same name.
+void ProcessRegistry::add(const string& name, shared_ptr<Screen> screen, ProcessState state) {
+    Shard& shard = shardFor(name);
+    lock_guard<ProfiledMutex> lock(shard.mutex);
+    auto existing = shard.entries.find(name);
+    if (existing != shard.entries.end()) {
+        const Entry& old = existing->second;
+        stateCounts[static_cast<int>(old.position->state)].fetch_sub(1, memory_order_relaxed);
+        (old.finished ? shard.finished : shard.active).erase(old.position);
+        shard.entries.erase(existing);
+        total.fetch_sub(1, memory_order_relaxed);
+    }
+
+    // Numbered under the shard lock, so each shard's list is in sequence order.
+    uint64_t arrival = nextArrival.fetch_add(1, memory_order_relaxed);
+    shard.active.push_back(Node{ arrival, state, move(screen) });
+    shard.entries.emplace(name, Entry{ false, prev(shard.active.end()) });
+    stateCounts[static_cast<int>(state)].fetch_add(1, memory_order_relaxed);
+    total.fetch_add(1, memory_order_relaxed);
+}
+
+// Returns the screen registered under name, or nullptr.
+shared_ptr<Screen> ProcessRegistry::find(const string& name) const {
+    const Shard& shard = shardFor(name);
+    lock_guard<ProfiledMutex> lock(shard.mutex);
+    auto it = shard.entries.find(name);
+    return it != shard.entries.end() ? it->second.position->screen : nullptr;
+}
+
+bool ProcessRegistry::contains(const string& name) const {
+    const Shard& shard = shardFor(name);
+    lock_guard<ProfiledMutex> lock(shard.mutex);
+    return shard.entries.count(name) > 0;
+}
+
+// Records a state change. Active screens keep their place in arrival order; a screen that
+// finishes is numbered and moved to the end of the finished list. Unknown names are ignored.
+void ProcessRegistry::setState(const string& name, ProcessState state) {
+    Shard& shard = shardFor(name);
+    lock_guard<ProfiledMutex> lock(shard.mutex);
+    auto it = shard.entries.find(name);
+    if (it == shard.entries.end()) return;
+    Entry& entry = it->second;
+    ProcessState oldState = entry.position->state;
+    if (oldState == state) return;
+
+    if (isFinishedState(state) && !entry.finished) {
+        entry.position->sequence = nextCompletion.fetch_add(1, memory_order_relaxed);
+        shard.finished.splice(shard.finished.end(), shard.active, entry.position);
+        entry.finished = true;
+    }
+    entry.position->state = state;
+    stateCounts[static_cast<int>(oldState)].fetch_sub(1, memory_order_relaxed);
+    stateCounts[static_cast<int>(state)].fetch_add(1, memory_order_relaxed);
+}
+
+// Returns the number of screens in a state without taking any lock.
+int ProcessRegistry::count(ProcessState state) const {
+    return stateCounts[static_cast<int>(state)].load(memory_order_relaxed);
+}
+
+int ProcessRegistry::size() const {
+    return total.load(memory_order_relaxed);
+}
+
+// Active-list nodes that snapshots report: registered processes that have been queued.
+bool ProcessRegistry::isListedActive(const Node& node) {
+    return node.state != ProcessState::NEW && node.state != ProcessState::CONSOLE;
+}
+
+// Appends the nodes accepted by keep, with their sequence numbers. The caller holds the shard lock.
+template <typename Filter>
+void ProcessRegistry::copyNodes(const OrderedList& nodes, Filter keep, ShardCopy& out) {
+    for (const Node& node : nodes) {
+        if (keep(node)) out.emplace_back(node.sequence, node.screen);
+    }
+}
+
+// Merges the per-shard copies by sequence number. Each copy is already ordered, so this
+// is a k-way merge rather than a sort, and it runs with no shard locked.
+void ProcessRegistry::mergeInOrder(const array<ShardCopy, SHARD_COUNT>& copies, vector<shared_ptr<Screen>>& out) {
+    using Cursor = pair<ShardCopy::const_iterator, ShardCopy::const_iterator>; // (next, end)
+    auto later = [](const Cursor& a, const Cursor& b) { return a.first->first > b.first->first; };
+    priority_queue<Cursor, vector<Cursor>, decltype(later)> heads(later);
+    size_t total = 0;
+    for (const ShardCopy& copy : copies) {
+        if (!copy.empty()) heads.push({ copy.begin(), copy.end() });
+        total += copy.size();
+    }
+    out.reserve(out.size() + total);
+    while (!heads.empty()) {
+        Cursor cursor = heads.top();
+        heads.pop();
+        out.push_back(cursor.first->second);
+        if (++cursor.first != cursor.second) heads.push(cursor);
+    }
+}
+
+// Copies the active processes in arrival order and, optionally, the finished ones in
+// completion order. Shards are locked one at a time, and each process lives in exactly one
+// shard, so none is missed or seen twice; the copy is consistent per shard, not across them.
+// Callers that do not need the finished processes skip copying them entirely.
+ProcessRegistry::Snapshot ProcessRegistry::snapshot(bool includeFinished) const {
+    array<ShardCopy, SHARD_COUNT> active, finished;
+    for (int i = 0; i < SHARD_COUNT; ++i) {
+        lock_guard<ProfiledMutex> lock(shards[i].mutex);
+        copyNodes(shards[i].active, isListedActive, active[i]);
+        if (includeFinished) copyNodes(shards[i].finished, [](const Node&) { return true; }, finished[i]);
+    }
+
+    Snapshot result;
+    mergeInOrder(active, result.active);
+    mergeInOrder(finished, result.finished);
+    return result;
+}
+
+// Copies the processes in one state, in arrival order (or completion order once finished).
+vector<shared_ptr<Screen>> ProcessRegistry::snapshotState(ProcessState state) const {
+    array<ShardCopy, SHARD_COUNT> copies;
+    for (int i = 0; i < SHARD_COUNT; ++i) {
+        lock_guard<ProfiledMutex> lock(shards[i].mutex);
+        copyNodes(isFinishedState(state) ? shards[i].finished : shards[i].active,
+            [state](const Node& node) { return node.state == state; }, copies[i]);
+    }
+
+    vector<shared_ptr<Screen>> result;
+    mergeInOrder(copies, result);
+    return result;
+}
+
+// Copies every registered screen, in no particular order.
+vector<shared_ptr<Screen>> ProcessRegistry::snapshotAll() const {
+    vector<shared_ptr<Screen>> all;
+    all.reserve(size());
+    for (const Shard& shard : shards) {
+        lock_guard<ProfiledMutex> lock(shard.mutex);
+        for (const auto& node : shard.active) all.push_back(node.screen);
+        for (const auto& node : shard.finished) all.push_back(node.screen);
+    }
+    return all;
+}
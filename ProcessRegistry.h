@@ -0,0 +1,90 @@
+#pragma once
+#include "Screen.h"
+#include "ProfiledMutex.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Lifecycle state a registered screen is indexed under.
+enum class ProcessState {
+    NEW,      // registered but not yet queued
+    READY,    // waiting in the ready queue
+    RUNNING,  // executing on a core
+    BLOCKED,  // parked on a page fault
+    FINISHED,
+    VIOLATED, // shut down by a memory access violation
+    CONSOLE,  // a screen that is not a process, such as the 'main' console
+    COUNT
+};
+
+// Thread-safe registry of every screen by name. Names are spread over shards by hash so
+// the generator, the cores and the display commands rarely contend for the same lock.
+// Each shard keeps its active screens in arrival order and its finished ones in completion
+// order, tagged with global sequence numbers; a state change only flips a field or splices
+// one node, so the lists stay ordered without sorting and counts per state are O(1).
+class ProcessRegistry {
+public:
+    static const int SHARD_COUNT = 16;
+    static const int STATE_COUNT = static_cast<int>(ProcessState::COUNT);
+
+    // Point-in-time copy of the registered processes.
+    struct Snapshot {
+        std::vector<std::shared_ptr<Screen>> active;   // READY, RUNNING and BLOCKED, in arrival order
+        std::vector<std::shared_ptr<Screen>> finished; // FINISHED and VIOLATED, in completion order
+    };
+
+    // Registration and Lookup
+    void add(const std::string& name, std::shared_ptr<Screen> screen, ProcessState state = ProcessState::NEW);
+    std::shared_ptr<Screen> find(const std::string& name) const;
+    bool contains(const std::string& name) const;
+
+    // State Tracking
+    void setState(const std::string& name, ProcessState state);
+    int count(ProcessState state) const;
+    int size() const;
+
+    // Snapshots
+    Snapshot snapshot(bool includeFinished = true) const;
+    std::vector<std::shared_ptr<Screen>> snapshotState(ProcessState state) const;
+    std::vector<std::shared_ptr<Screen>> snapshotAll() const;
+
+private:
+    struct Node {
+        uint64_t sequence; // arrival number in the active list, completion number in the finished list
+        ProcessState state;
+        std::shared_ptr<Screen> screen;
+    };
+    using OrderedList = std::list<Node>;
+    struct Entry {
+        bool finished;
+        OrderedList::iterator position;
+    };
+    struct alignas(64) Shard {
+        mutable ProfiledMutex mutex{ "ProcessRegistry::shard" };
+        std::unordered_map<std::string, Entry> entries;
+        OrderedList active;
+        OrderedList finished;
+    };
+
+    // One shard's copy of a list, taken under that shard's lock and merged after it is released.
+    using ShardCopy = std::vector<std::pair<uint64_t, std::shared_ptr<Screen>>>;
+
+    Shard& shardFor(const std::string& name);
+    const Shard& shardFor(const std::string& name) const;
+    static bool isFinishedState(ProcessState state);
+    static bool isListedActive(const Node& node);
+    template <typename Filter>
+    static void copyNodes(const OrderedList& nodes, Filter keep, ShardCopy& out);
+    static void mergeInOrder(const std::array<ShardCopy, SHARD_COUNT>& copies, std::vector<std::shared_ptr<Screen>>& out);
+
+    std::array<Shard, SHARD_COUNT> shards;
+    std::atomic<uint64_t> nextArrival{ 0 };
+    std::atomic<uint64_t> nextCompletion{ 0 };
+    std::atomic<int> stateCounts[STATE_COUNT] = {};
+    std::atomic<int> total{ 0 };
+};
@@ -0,0 +1,107 @@
+#include "ProfiledMutex.h"
+#include "Clock.h"
+#include <map>
+#include <memory>
+using namespace std;
+
+std::atomic<bool> ProfiledMutex::profilingEnabled{ false };
+
+// Registry of counters by lock name. Counters are never freed, so pointers stay valid.
+static mutex& registryMutex() {
+    static mutex m;
+    return m;
+}
+static map<string, unique_ptr<LockCounters>>& registry() {
+    static map<string, unique_ptr<LockCounters>> counters;
+    return counters;
+}
+
+// Raises target to value if value is larger.
+static void updateMax(atomic<long long>& target, long long value) {
+    long long current = target.load(memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, memory_order_relaxed)) {}
+}
+
+// Constructor: attaches the mutex to the counters of its name.
+ProfiledMutex::ProfiledMutex(const char* name) {
+    lock_guard<mutex> lock(registryMutex());
+    auto& slot = registry()[name];
+    if (!slot) {
+        slot = make_unique<LockCounters>();
+        slot->name = name;
+    }
+    counters = slot.get();
+}
+
+// Acquires the mutex, timing the wait only when the fast try_lock fails.
+void ProfiledMutex::lockProfiled() {
+    if (!impl.try_lock()) {
+        long long waitStart = Clock::monotonicNanos();
+        impl.lock();
+        long long waited = Clock::monotonicNanos() - waitStart;
+        counters->contended.fetch_add(1, memory_order_relaxed);
+        counters->totalWaitNanos.fetch_add(waited, memory_order_relaxed);
+        updateMax(counters->maxWaitNanos, waited);
+    }
+    counters->acquisitions.fetch_add(1, memory_order_relaxed);
+    lockedAtNanos = Clock::monotonicNanos();
+}
+
+// Records the hold time and releases the mutex.
+void ProfiledMutex::unlockProfiled() {
+    long long held = Clock::monotonicNanos() - lockedAtNanos;
+    lockedAtNanos = 0;
+    counters->totalHoldNanos.fetch_add(held, memory_order_relaxed);
+    updateMax(counters->maxHoldNanos, held);
+    impl.unlock();
+}
+
+bool ProfiledMutex::try_lock() {
+    if (!impl.try_lock()) return false;
+#ifndef NO_LOCK_PROFILING
+    if (profilingEnabled.load(memory_order_relaxed)) {
+        counters->acquisitions.fetch_add(1, memory_order_relaxed);
+        lockedAtNanos = Clock::monotonicNanos();
+    }
+#endif
+    return true;
+}
+
+void ProfiledMutex::setProfilingEnabled(bool enabled) {
+    profilingEnabled.store(enabled);
+}
+
+bool ProfiledMutex::isProfilingEnabled() {
+    return profilingEnabled.load();
+}
+
+// Returns a copy of every lock's counters, ordered by name.
+vector<LockStats> ProfiledMutex::getAllStats() {
+    lock_guard<mutex> lock(registryMutex());
+    vector<LockStats> all;
+    for (const auto& [name, counters] : registry()) {
+        LockStats stats;
+        stats.name = name;
+        stats.acquisitions = counters->acquisitions.load();
+        stats.contended = counters->contended.load();
+        stats.totalWaitNanos = counters->totalWaitNanos.load();
+        stats.maxWaitNanos = counters->maxWaitNanos.load();
+        stats.totalHoldNanos = counters->totalHoldNanos.load();
+        stats.maxHoldNanos = counters->maxHoldNanos.load();
+        all.push_back(stats);
+    }
+    return all;
+}
+
+// Clears every lock's counters.
+void ProfiledMutex::resetAllStats() {
+    lock_guard<mutex> lock(registryMutex());
+    for (auto& [name, counters] : registry()) {
+        counters->acquisitions = 0;
+        counters->contended = 0;
+        counters->totalWaitNanos = 0;
+        counters->maxWaitNanos = 0;
+        counters->totalHoldNanos = 0;
+        counters->maxHoldNanos = 0;
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Counters shared by every ProfiledMutex with the same name.
+struct LockCounters {
+    std::string name;
+    std::atomic<long long> acquisitions{ 0 };
+    std::atomic<long long> contended{ 0 };
+    std::atomic<long long> totalWaitNanos{ 0 };
+    std::atomic<long long> maxWaitNanos{ 0 };
+    std::atomic<long long> totalHoldNanos{ 0 };
+    std::atomic<long long> maxHoldNanos{ 0 };
+};
+
+// Plain copy of a lock's counters for display.
+struct LockStats {
+    std::string name;
+    long long acquisitions = 0;
+    long long contended = 0;
+    long long totalWaitNanos = 0;
+    long long maxWaitNanos = 0;
+    long long totalHoldNanos = 0;
+    long long maxHoldNanos = 0;
+};
+
+// A std::mutex that can record acquisitions, contended acquisitions and wait/hold
+// times under a name. Profiling is off until setProfilingEnabled(true) ('lockstat on'
+// or the lock-profiling config key); until then lock() costs one relaxed load extra.
+// Building with -DNO_LOCK_PROFILING reduces it to a plain std::mutex.
+class ProfiledMutex {
+public:
+    explicit ProfiledMutex(const char* name);
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    // Lockable
+    void lock() {
+#ifndef NO_LOCK_PROFILING
+        if (profilingEnabled.load(std::memory_order_relaxed)) {
+            lockProfiled();
+            return;
+        }
+#endif
+        impl.lock();
+    }
+    void unlock() {
+#ifndef NO_LOCK_PROFILING
+        if (lockedAtNanos != 0) {
+            unlockProfiled();
+            return;
+        }
+#endif
+        impl.unlock();
+    }
+    bool try_lock();
+
+    // Profiling Control and Statistics
+    static void setProfilingEnabled(bool enabled);
+    static bool isProfilingEnabled();
+    static std::vector<LockStats> getAllStats();
+    static void resetAllStats();
+
+private:
+    void lockProfiled();
+    void unlockProfiled();
+
+    std::mutex impl;
+    LockCounters* counters;
+    long long lockedAtNanos = 0; // set by the owner while profiling; 0 = not timed
+    static std::atomic<bool> profilingEnabled;
+};
@@ -0,0 +1,272 @@
+#include "ReportWriter.h"
+#include "Scheduler.h"
+#include "ScreenManager.h"
+#include "Clock.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+// Formats a process's scheduling metrics (in ticks) for the screen -ls and report-util listings.
+string formatMetrics(const ProcessMetrics& metrics, bool finished) {
+    stringstream ss;
+    ss << "\t[";
+    if (finished) {
+        ss << "tat " << metrics.turnaroundTicks() << " resp " << metrics.responseTicks() << " ";
+    }
+    ss << "wait " << metrics.readyWaitTicks << " cpu " << metrics.cpuTicks;
+    if (metrics.blockedTicks > 0) ss << " blk " << metrics.blockedTicks;
+    ss << " disp " << metrics.dispatchCount << "]";
+    return ss.str();
+}
+
+// Writes the average and percentiles of each scheduling metric over the finished processes.
+void writeSchedulingSummary(ostream& out, const vector<shared_ptr<Screen>>& finishedProcesses) {
+    if (finishedProcesses.empty()) return;
+
+    vector<pair<string, vector<int>>> columns = {
+        { "Turnaround", {} }, { "Response", {} }, { "Ready wait", {} },
+        { "CPU", {} }, { "Blocked", {} }, { "Dispatches", {} }
+    };
+    for (const auto& screen : finishedProcesses) {
+        ProcessMetrics metrics = screen->getMetrics();
+        if (metrics.completionTick < 0) continue;
+        columns[0].second.push_back(metrics.turnaroundTicks());
+        columns[1].second.push_back(metrics.responseTicks());
+        columns[2].second.push_back(metrics.readyWaitTicks);
+        columns[3].second.push_back(metrics.cpuTicks);
+        columns[4].second.push_back(metrics.blockedTicks);
+        columns[5].second.push_back(metrics.dispatchCount);
+    }
+    if (columns[0].second.empty()) return;
+
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << "\nScheduling metrics (ticks) over " << columns[0].second.size() << " finished processes:\n";
+    out << left << setw(12) << "" << right << setw(10) << "avg" << setw(8) << "p50"
+        << setw(8) << "p90" << setw(8) << "p99" << setw(8) << "max" << "\n";
+    for (auto& [label, values] : columns) {
+        sort(values.begin(), values.end());
+        double total = 0;
+        for (int v : values) total += v;
+        auto at = [&](double p) { return values[static_cast<size_t>(p * (values.size() - 1) + 0.5)]; };
+        out << left << setw(12) << label << right << fixed << setprecision(1) << setw(10) << total / values.size()
+            << setw(8) << at(0.50) << setw(8) << at(0.90) << setw(8) << at(0.99) << setw(8) << values.back() << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+ReportWriter::~ReportWriter() {
+    stop();
+}
+
+void ReportWriter::setFormat(ReportFormat value) { format = value; }
+void ReportWriter::setIntervalTicks(int ticks) { intervalTicks = max(0, ticks); }
+void ReportWriter::setRotateCount(int count) { rotateCount = max(0, count); }
+
+// Returns the report file for the configured format.
+string ReportWriter::getPath() const {
+    switch (format) {
+    case ReportFormat::CSV: return "csopesy-log.csv";
+    case ReportFormat::JSON: return "csopesy-log.json";
+    default: return "csopesy-log.txt";
+    }
+}
+
+bool ReportWriter::parseFormat(const string& name, ReportFormat& value) {
+    if (name == "text") value = ReportFormat::TEXT;
+    else if (name == "csv") value = ReportFormat::CSV;
+    else if (name == "json") value = ReportFormat::JSON;
+    else return false;
+    return true;
+}
+
+void ReportWriter::start() {
+    lock_guard<mutex> lock(queueMutex);
+    if (running) return;
+    running = true;
+    worker = thread(&ReportWriter::run, this);
+}
+
+void ReportWriter::stop() {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        if (!running) return;
+        running = false;
+    }
+    queueCondition.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+// Queues a report and returns immediately.
+void ReportWriter::requestReport() {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        requested++;
+    }
+    queueCondition.notify_one();
+}
+
+// Called by the tick thread; queues a report every intervalTicks ticks.
+void ReportWriter::onTick(int tick) {
+    if (intervalTicks > 0 && tick % intervalTicks == 0) requestReport();
+}
+
+void ReportWriter::waitUntilWritten() {
+    unique_lock<mutex> lock(queueMutex);
+    long long target = requested;
+    writtenCondition.wait(lock, [this, target]() { return written >= target || !running; });
+}
+
+long long ReportWriter::getReportsWritten() const {
+    return reportsWritten.load();
+}
+
+// Writes reports until stopped. Requests that pile up while a report is being written
+// are served by a single report, since it reflects the latest state anyway.
+void ReportWriter::run() {
+    unique_lock<mutex> lock(queueMutex);
+    while (true) {
+        queueCondition.wait(lock, [this]() { return written < requested || !running; });
+        if (written >= requested) break; // stopped with nothing queued
+        long long target = requested;
+        lock.unlock();
+        if (writeReport()) reportsWritten++;
+        else cerr << "Failed to write report '" << getPath() << "'." << endl;
+        lock.lock();
+        written = target;
+        writtenCondition.notify_all();
+    }
+}
+
+// Shifts <file>.(n-1) to <file>.n, ..., <file> to <file>.1, dropping the oldest.
+void ReportWriter::rotateFiles() const {
+    string path = getPath();
+    remove((path + "." + to_string(rotateCount)).c_str());
+    for (int i = rotateCount - 1; i >= 1; --i) {
+        rename((path + "." + to_string(i)).c_str(), (path + "." + to_string(i + 1)).c_str());
+    }
+    rename(path.c_str(), (path + ".1").c_str());
+}
+
+// Takes one snapshot and streams it to the report file.
+bool ReportWriter::writeReport() {
+    ScreenManager* screenManager = ScreenManager::getInstance();
+    if (!screenManager || !Scheduler::getInstance()) return false;
+    ProcessRegistry::Snapshot processes = screenManager->snapshotProcesses();
+
+    string path = getPath();
+    string temporaryPath = path + ".tmp";
+    {
+        vector<char> buffer(1 << 16);
+        ofstream out;
+        out.rdbuf()->pubsetbuf(buffer.data(), static_cast<streamsize>(buffer.size()));
+        out.open(temporaryPath, ios::out | ios::trunc);
+        if (!out) return false;
+        switch (format) {
+        case ReportFormat::CSV: writeCsv(out, processes.active, processes.finished); break;
+        case ReportFormat::JSON: writeJson(out, processes.active, processes.finished); break;
+        default: writeText(out, processes.active, processes.finished); break;
+        }
+        out.flush();
+        if (!out) return false;
+    }
+
+    if (rotateCount > 0) rotateFiles();
+    else remove(path.c_str());
+    return rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+// The human-readable report, in the same layout as screen -ls.
+void ReportWriter::writeText(ostream& out, const vector<shared_ptr<Screen>>& active,
+    const vector<shared_ptr<Screen>>& finished) const {
+    Scheduler* scheduler = Scheduler::getInstance();
+    out << "CPU utilization: " << (scheduler->getUsedCores() * 100 / scheduler->getAvailableCores()) << "%\n";
+    out << "Cores used: " << scheduler->getUsedCores() << "\n";
+    out << "Cores available: " << scheduler->getAvailableCores() << "\n";
+    out << "--------------------------------------------------------------------------------\n";
+    out << "Running processes:\n";
+    if (active.empty()) {
+        out << " (None)\n";
+    }
+    else {
+        for (const auto& screen : active) {
+            out << left << setw(10) << screen->getName()
+                << " (" << screen->getTimestamp() << ")";
+            if (screen->getCoreID() != -1) {
+                out << "\tCore: " << screen->getCoreID();
+            }
+            out << "\t" << screen->getProgramCounter() << " / " << screen->getTotalInstructions()
+                << formatMetrics(screen->getMetrics(), false) << "\n";
+        }
+    }
+
+    out << "\nFinished processes:\n";
+    if (finished.empty()) {
+        out << " (None)\n";
+    }
+    else {
+        for (const auto& screen : finished) {
+            out << left << setw(10) << screen->getName()
+                << " (" << screen->getTimestampFinished() << ")"
+                << "\tFinished"
+                << "\t" << screen->getProgramCounter() << " / " << screen->getTotalInstructions()
+                << formatMetrics(screen->getMetrics(), true) << "\n";
+        }
+    }
+    writeSchedulingSummary(out, finished);
+    out << "--------------------------------------------------------------------------------\n";
+}
+
+// One row per process; times are epoch seconds and ticks, -1/0 when not reached yet.
+void ReportWriter::writeCsv(ostream& out, const vector<shared_ptr<Screen>>& active,
+    const vector<shared_ptr<Screen>>& finished) const {
+    out << "name,state,core,instruction,instructions,created,finished,arrival_tick,first_dispatch_tick,"
+        "completion_tick,cpu_ticks,ready_wait_ticks,blocked_ticks,dispatches\n";
+    for (const auto* list : { &active, &finished }) {
+        for (const auto& screen : *list) {
+            ProcessMetrics metrics = screen->getMetrics();
+            out << screen->getName() << ',' << screen->getStateName() << ',' << screen->getCoreID() << ','
+                << screen->getProgramCounter() << ',' << screen->getTotalInstructions() << ','
+                << static_cast<long long>(screen->getCreatedTime()) << ',' << static_cast<long long>(screen->getFinishedTime()) << ','
+                << metrics.arrivalTick << ',' << metrics.firstDispatchTick << ',' << metrics.completionTick << ','
+                << metrics.cpuTicks << ',' << metrics.readyWaitTicks << ',' << metrics.blockedTicks << ','
+                << metrics.dispatchCount << '\n';
+        }
+    }
+}
+
+// The same rows as the CSV report, plus the scheduler totals, as one JSON document.
+void ReportWriter::writeJson(ostream& out, const vector<shared_ptr<Screen>>& active,
+    const vector<shared_ptr<Screen>>& finished) const {
+    Scheduler* scheduler = Scheduler::getInstance();
+    out << "{\n";
+    out << "  \"time\": " << static_cast<long long>(Clock::wallTime()) << ",\n";
+    out << "  \"tick\": " << scheduler->getCpuCycles() << ",\n";
+    out << "  \"coresUsed\": " << scheduler->getUsedCores() << ",\n";
+    out << "  \"coresAvailable\": " << scheduler->getAvailableCores() << ",\n";
+    out << "  \"instructionsExecuted\": " << scheduler->getInstructionsExecuted() << ",\n";
+    out << "  \"processes\": [";
+    bool first = true;
+    for (const auto* list : { &active, &finished }) {
+        for (const auto& screen : *list) {
+            ProcessMetrics metrics = screen->getMetrics();
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "    {\"name\": \"" << screen->getName() << "\", \"state\": \"" << screen->getStateName()
+                << "\", \"core\": " << screen->getCoreID()
+                << ", \"instruction\": " << screen->getProgramCounter() << ", \"instructions\": " << screen->getTotalInstructions()
+                << ", \"created\": " << static_cast<long long>(screen->getCreatedTime())
+                << ", \"finished\": " << static_cast<long long>(screen->getFinishedTime())
+                << ", \"arrivalTick\": " << metrics.arrivalTick << ", \"firstDispatchTick\": " << metrics.firstDispatchTick
+                << ", \"completionTick\": " << metrics.completionTick << ", \"cpuTicks\": " << metrics.cpuTicks
+                << ", \"readyWaitTicks\": " << metrics.readyWaitTicks << ", \"blockedTicks\": " << metrics.blockedTicks
+                << ", \"dispatches\": " << metrics.dispatchCount << "}";
+        }
+    }
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "Screen.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Formats a process's scheduling metrics (in ticks) for the screen -ls and report-util listings.
+std::string formatMetrics(const ProcessMetrics& metrics, bool finished);
+// Writes the average and percentiles of each scheduling metric over the finished processes.
+void writeSchedulingSummary(std::ostream& out, const std::vector<std::shared_ptr<Screen>>& finishedProcesses);
+
+enum class ReportFormat { TEXT, CSV, JSON };
+
+// Writes the report-util report on its own thread, on demand or every N ticks, so the
+// CLI and the cores never wait for it. Each report is built from one registry snapshot,
+// streamed through a large buffer to a temporary file and renamed over the report, after
+// the previous reports have been rotated to <file>.1 ... <file>.<rotate>.
+class ReportWriter {
+public:
+    ~ReportWriter();
+
+    // Configuration (report-format, report-interval-ticks, report-rotate)
+    void setFormat(ReportFormat format);
+    void setIntervalTicks(int ticks);
+    void setRotateCount(int count);
+    std::string getPath() const;
+    static bool parseFormat(const std::string& name, ReportFormat& format);
+
+    // Thread Control
+    void start();
+    void stop(); // writes any report still queued, then joins
+
+    // Triggers
+    void requestReport();
+    void onTick(int tick);
+    void waitUntilWritten(); // blocks until every requested report is on disk
+
+    // Statistics
+    long long getReportsWritten() const;
+
+private:
+    void run();
+    bool writeReport();
+    void rotateFiles() const;
+    void writeText(std::ostream& out, const std::vector<std::shared_ptr<Screen>>& active,
+        const std::vector<std::shared_ptr<Screen>>& finished) const;
+    void writeCsv(std::ostream& out, const std::vector<std::shared_ptr<Screen>>& active,
+        const std::vector<std::shared_ptr<Screen>>& finished) const;
+    void writeJson(std::ostream& out, const std::vector<std::shared_ptr<Screen>>& active,
+        const std::vector<std::shared_ptr<Screen>>& finished) const;
+
+    ReportFormat format = ReportFormat::TEXT;
+    int intervalTicks = 0; // 0 = only on demand
+    int rotateCount = 0;   // 0 = overwrite the report each time
+
+    std::thread worker;
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::condition_variable writtenCondition;
+    long long requested = 0; // reports asked for so far
+    long long written = 0;   // reports finished (written or failed) so far
+    bool running = false;
+    std::atomic<long long> reportsWritten{ 0 };
+};
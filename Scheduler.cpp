@@ -1,6 +1,7 @@
 #include "Scheduler.h"
 #include "ScreenManager.h"
 #include "CLIController.h"
+#include "Clock.h"
 #include "Instruction.h"
 #include "MemoryManager.h"
 #include <iostream>
@@ -12,6 +13,9 @@
 #include <random>
 #include <atomic>
 #include <functional>
+#include <sstream>
+#include <algorithm>
+#include "CommandInputController.h"
 
 using namespace std;
 
@@ -21,17 +25,21 @@ std::mutex Scheduler::scheduler_init_mutex;
 
 // Initializes scheduler state variables.
 Scheduler::Scheduler()
-    : numCores(0), coresUsed(0), coresAvailable(0),
+    : numCores(0), coresAvailable(0),
     schedulerRunning(false), activeThreads(0) {
 }
 
 // Initializes the singleton instance of the Scheduler and loads its configuration.
-void Scheduler::initialize() {
+void Scheduler::initialize(const std::string& configPath) {
     if (scheduler == nullptr) {
         lock_guard<mutex> lock(scheduler_init_mutex);
         if (scheduler == nullptr) {
             scheduler = new Scheduler();
-            scheduler->loadConfig();
+            scheduler->loadConfig(configPath);
+            scheduler->coreSlots.reset(new CoreSlot[scheduler->numCores]);
+            scheduler->seedRandomStreams();
+            scheduler->reporter.start();
+            scheduler->metrics.start();
         }
     }
 }
@@ -47,11 +55,29 @@ string Scheduler::getAlgorithm() const { return algorithm; }
 
 // Adds a process to the ready queue to be executed.
 void Scheduler::addProcessToQueue(shared_ptr<Screen> screen) {
-    lock_guard<mutex> lock(processQueueMutex);
+    // Indexed before the push so a core that pops it can only move it on to RUNNING.
+    indexProcess(screen, ProcessState::READY);
+    lock_guard<ProfiledMutex> lock(processQueueMutex);
+    screen->markReady(cpuCycles.load());
     processQueue.push(screen);
     processQueueCondition.notify_one();
 }
 
+// Moves a process to another state index of the ScreenManager registry.
+void Scheduler::indexProcess(const shared_ptr<Screen>& process, ProcessState state) {
+    ScreenManager* screenManager = ScreenManager::getInstance();
+    if (screenManager) screenManager->setProcessState(process->getName(), state);
+}
+
+// Records a finished process: indexes it, frees its memory and archives its log and program.
+void Scheduler::retireProcess(const shared_ptr<Screen>& process) {
+    process->markCompleted(cpuCycles.load());
+    indexProcess(process, process->hasMemoryViolation() ? ProcessState::VIOLATED : ProcessState::FINISHED);
+    MemoryManager::getInstance()->deallocate(process->getName());
+    ScreenManager* screenManager = ScreenManager::getInstance();
+    if (archiveFinished && screenManager) screenManager->archiveProcess(process);
+}
+
 // Starts the scheduler's worker threads to begin processing the queue.
 void Scheduler::start() {
     if (schedulerRunning) return;
@@ -60,6 +86,13 @@ void Scheduler::start() {
 
     // Initialize the memory manager with configured values.
     MemoryManager::initialize(maxOverallMem,memPerFrame);
+    MemoryManager::getInstance()->enableCompressedSwap(compressedSwapSize);
+    MemoryManager::getInstance()->startPageMerging(pageMergeIntervalMs);
+    if (asyncPageFaults) MemoryManager::getInstance()->startPager();
+    eventTrace.allocate(numCores, traceEventsPerCore);
+    if (archiveFinished && ScreenManager::getInstance()) {
+        ScreenManager::getInstance()->openArchive("csopesy-archive.txt");
+    }
     // Create a pool of worker threads based on the number of CPU cores.
     workerThreads.clear();
     for (int i = 0; i < numCores; i++) {
@@ -67,7 +100,7 @@ void Scheduler::start() {
             while (this->schedulerRunning) {
                 shared_ptr<Screen> process;
                 {
-                    unique_lock<mutex> lock(this->processQueueMutex);
+                    unique_lock<ProfiledMutex> lock(this->processQueueMutex);
                     this->processQueueCondition.wait(lock, [this]() {
                         return !this->processQueue.empty() || !this->schedulerRunning;
                         });
@@ -83,23 +116,55 @@ void Scheduler::start() {
                     // If the process has already finished (e.g., memory violation),
                     // just deallocate its resources and continue.
                     if (process->isFinished()) {
-                        MemoryManager::getInstance()->deallocate(process->getName());
+                        retireProcess(process);
                         continue; // Skip to the next process
                     }
 
-                    coresUsed++;
                     process->setCoreID(i);
+                    process->markDispatched(cpuCycles.load());
+                    publishCoreProcess(i, process.get());
+                    coreSlots[i].busy.store(true, memory_order_relaxed);
+                    indexProcess(process, ProcessState::RUNNING);
+                    eventTrace.record(i, SchedulerEventType::DISPATCH, process->getName(), cpuCycles.load());
 
-                    // Execute for a quantum (RR) or to completion (FCFS).
-                    process->execute(algorithm == "rr" ? quantumCycles : -1);
+                    // Keep the symbol table (page 0) resident while the process holds the core.
+                    // With async faults a missing page 0 is left for the pager instead.
+                    MemoryManager::getInstance()->pinPage(process->getName(), 0x0, !asyncPageFaults);
 
-                    coresUsed--;
+                    // Execute for a quantum (RR) or to completion (FCFS).
+                    int pcBefore = process->getProgramCounter();
+                    ExecutionStatus status = process->execute(algorithm == "rr" ? quantumCycles : -1);
+                    int executed = process->getProgramCounter() - pcBefore;
+                    instructionsExecuted += executed;
+                    coreSlots[i].instructions.fetch_add(executed, memory_order_relaxed);
+
+                    MemoryManager::getInstance()->unpinPage(process->getName(), 0x0);
+                    coreSlots[i].busy.store(false, memory_order_relaxed);
+                    publishCoreProcess(i, nullptr);
+                    process->markDescheduled(cpuCycles.load());
+
+                    // Park the process while the pager loads its pages; the pager requeues it.
+                    if (status == ExecutionStatus::BLOCKED_ON_PAGE_FAULT) {
+                        eventTrace.record(i, SchedulerEventType::PREEMPT, process->getName(), cpuCycles.load(), 1);
+                        blockedProcesses++;
+                        process->markBlocked(cpuCycles.load());
+                        indexProcess(process, ProcessState::BLOCKED);
+                        MemoryManager::getInstance()->requestPageIn(process->getName(), process->getPendingPages(), [this, process]() {
+                            blockedProcesses--;
+                            process->markUnblocked(cpuCycles.load());
+                            process->setBlockedOnPageFault(false);
+                            addProcessToQueue(process);
+                        });
+                        continue;
+                    }
 
                     // If process is finished now, deallocate its memory. Otherwise, requeue it.
                     if (process->isFinished()) {
-                        MemoryManager::getInstance()->deallocate(process->getName());
+                        eventTrace.record(i, SchedulerEventType::FINISH, process->getName(), cpuCycles.load(), process->hasMemoryViolation() ? 1 : 0);
+                        retireProcess(process);
                     }
                     else {
+                        eventTrace.record(i, SchedulerEventType::PREEMPT, process->getName(), cpuCycles.load());
                         // If not finished (must be RR), put it back in the queue.
                         addProcessToQueue(process);
                     }
@@ -114,20 +179,10 @@ void Scheduler::startProcessGeneration() {
     if (getGeneratingProcesses()) return; // Already running
     setGeneratingProcesses(true);
 
+    // A replayed run takes every arrival, including the initial batch, from the log.
     int initialBatchSize = numCores > 0 ? numCores : 1;
-    for (int i = 0; i < initialBatchSize; ++i) {
-        auto screenName = "p" + to_string(generatedProcessCount++);
-
-       int memSize = getRandomPowerOf2(minMemPerProc, maxMemPerProc);
-
-        // Generate instructions and create the screen object.
-        auto instructions = generateInstructionsForProcess(screenName, memSize);
-        auto screen = make_shared<Screen>(screenName, instructions, CLIController::getInstance()->getTimestamp());
-
-        MemoryManager::getInstance()->setupProcessMemory(screenName, memSize);
-
-        ScreenManager::getInstance()->registerScreen(screenName, screen);
-        addProcessToQueue(screen);
+    for (int i = 0; i < initialBatchSize && replayArrivals.empty(); ++i) {
+        spawnGeneratedProcess();
     }
 
     if (!processGeneratorThread.joinable()) {
@@ -150,28 +205,49 @@ void Scheduler::stop() {
             t.join();
         }
     }
+
+    // Stop the pager once no worker can queue another page-in. It serves what is left, and
+    // its completions requeue processes through the ScreenManager, which main destroys
+    // before the MemoryManager.
+    if (MemoryManager::getInstance()) MemoryManager::getInstance()->stopPager();
+    reporter.stop();
+    metrics.stop();
     cout << "Scheduler has finished joining all its threads." << endl;
 }
 
 // Generates a set of random instructions for a new process.
 std::vector<Instruction> Scheduler::generateInstructionsForProcess(const std::string& screenName, int processMemorySize) {
+    return generateInstructionsForProcess(screenName, processMemorySize, getProgramSeed(screenName));
+}
+
+// Generates the instructions of a process from its own RNG stream, so the program depends only on programSeed.
+std::vector<Instruction> Scheduler::generateInstructionsForProcess(const std::string& screenName, int processMemorySize, unsigned long long programSeed) {
     // Random number generators
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> instr_dist(minInstructions, maxInstructions);
-    static std::uniform_int_distribution<> value_dist(1, 100);
+    std::mt19937 gen(static_cast<std::mt19937::result_type>(programSeed));
+    std::uniform_int_distribution<> instr_dist(minInstructions, maxInstructions);
+    std::uniform_int_distribution<> value_dist(1, 100);
+
+    // Instruction types in the order of the configured instruction-mix weights.
+    static const InstructionType mix_types[] = {
+        InstructionType::PRINT, InstructionType::DECLARE, InstructionType::ADD, InstructionType::SUBTRACT,
+        InstructionType::SLEEP, InstructionType::READ, InstructionType::WRITE
+    };
+    std::discrete_distribution<> type_dist(workload.instructionMix.begin(), workload.instructionMix.end());
+    AddressStream addresses(workload, processMemorySize, memPerFrame, gen);
 
     // Lambda to generate a single random instruction (excluding FOR)
     auto generateRandomInstruction = [&](const string& screenName) -> Instruction {
-        uniform_int_distribution<> type_dist(0, 5);
-        InstructionType type = static_cast<InstructionType>(type_dist(gen));
-
-        int max_addr = (processMemorySize > 1) ? (processMemorySize - 1) : 0;
-        uniform_int_distribution<> addr_dist(0, max_addr);
+        InstructionType type = mix_types[type_dist(gen)];
 
         switch (type) {
+        case InstructionType::DECLARE: {
+            Instruction declareInstr;
+            declareInstr.type = InstructionType::DECLARE;
+            declareInstr.operands = { {true, "var_" + to_string(value_dist(gen) % 5), 0}, {false, "", (uint16_t)value_dist(gen)} };
+            return declareInstr;
+        }
         case InstructionType::READ: {
-            uint16_t address = addr_dist(gen);
+            uint16_t address = addresses.next();
             Instruction readInstr;
             readInstr.type = InstructionType::READ;
             readInstr.operands = { {true, "var_" + to_string(value_dist(gen) % 5), 0} };
@@ -179,7 +255,7 @@ std::vector<Instruction> Scheduler::generateInstructionsForProcess(const std::st
             return readInstr;
         }
         case InstructionType::WRITE: {
-            uint16_t address = addr_dist(gen);
+            uint16_t address = addresses.next();
             Instruction writeInstr;
             writeInstr.type = InstructionType::WRITE;
             writeInstr.operands = { {false, "", (uint16_t)value_dist(gen)} };
@@ -241,32 +317,173 @@ std::vector<Instruction> Scheduler::generateInstructionsForProcess(const std::st
 void Scheduler::generateDummyProcesses() {
     while (schedulerRunning.load()) {
         if (generatingProcesses.load()) {
-            if (cpuCycles - lastGenCycle >= batchProcessFreq) {
+            if (!replayArrivals.empty()) {
+                replayDueArrivals();
+            }
+            else if (cpuCycles - lastGenCycle >= batchProcessFreq) {
                 lastGenCycle = cpuCycles;
+                spawnGeneratedProcess();
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+// Creates, registers and enqueues the next generated process "p<N>".
+shared_ptr<Screen> Scheduler::spawnGeneratedProcess() {
+    auto screenName = "p" + to_string(generatedProcessCount++);
+    int memSize = getRandomPowerOf2(minMemPerProc, maxMemPerProc);
+    unsigned long long programSeed = getProgramSeed(screenName);
+
+    // Generate instructions and create the screen object.
+    auto instructions = generateInstructionsForProcess(screenName, memSize, programSeed);
+    auto screen = make_shared<Screen>(screenName, instructions, Clock::wallTime());
 
-                auto screenName = "p" + to_string(generatedProcessCount++);
+    MemoryManager::getInstance()->setupProcessMemory(screenName, memSize, screen->getFaultCounters());
+
+    ScreenManager::getInstance()->registerScreen(screenName, screen);
+    logArrival(screenName, memSize, programSeed);
+    addProcessToQueue(screen);
+    return screen;
+}
+
+// Seeds the run from the 'seed' config key, or from random_device if none was given,
+// and loads the arrival log to replay if one was configured.
+void Scheduler::seedRandomStreams() {
+    if (!replayLogPath.empty()) {
+        loadReplayLog();
+    }
+    if (!seedConfigured) {
+        std::random_device rd;
+        runSeed = (static_cast<unsigned long long>(rd()) << 32) | rd();
+    }
+    memSizeGen.seed(static_cast<std::mt19937::result_type>(mixSeed(runSeed, 0x6D656D)));
+
+    if (!arrivalLogPath.empty()) {
+        arrivalLog.open(arrivalLogPath, ios::trunc);
+        if (arrivalLog) {
+            arrivalLog << "# seed " << runSeed << "\n";
+        }
+        else {
+            cerr << "Warning: could not open arrival log '" << arrivalLogPath << "'." << endl;
+        }
+    }
+}
+
+// SplitMix64 finalizer over the run seed and a stream id; gives well separated stream seeds.
+unsigned long long Scheduler::mixSeed(unsigned long long seed, unsigned long long stream) {
+    unsigned long long z = seed + 0x9E3779B97F4A7C15ULL * (stream + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Returns the seed of a process's program stream, derived from the run seed and the process name.
+unsigned long long Scheduler::getProgramSeed(const std::string& screenName) const {
+    // FNV-1a keeps the name hash stable across builds, unlike std::hash.
+    unsigned long long nameHash = 14695981039346656037ULL;
+    for (unsigned char c : screenName) {
+        nameHash = (nameHash ^ c) * 1099511628211ULL;
+    }
+    return mixSeed(runSeed, nameHash);
+}
+
+// Returns the seed of this run.
+unsigned long long Scheduler::getRunSeed() const {
+    return runSeed;
+}
+
+// Returns true if processes are being created from a replayed arrival log.
+bool Scheduler::isReplaying() const {
+    return !replayArrivals.empty();
+}
+
+// Records a generated process in the arrival log.
+void Scheduler::logArrival(const std::string& screenName, int memSize, unsigned long long programSeed) {
+    lock_guard<mutex> lock(arrivalLogMutex);
+    if (!arrivalLog) return;
+    arrivalLog << cpuCycles.load() << " " << screenName << " " << memSize << " gen " << programSeed << "\n";
+    arrivalLog.flush();
+}
+
+// Records a user-written process (screen -c) in the arrival log with its source text.
+void Scheduler::logArrival(const std::string& screenName, int memSize, const std::string& program) {
+    lock_guard<mutex> lock(arrivalLogMutex);
+    if (!arrivalLog) return;
+    arrivalLog << cpuCycles.load() << " " << screenName << " " << memSize << " user " << program << "\n";
+    arrivalLog.flush();
+}
+
+// Reads an arrival log written by a previous run. Its seed becomes this run's seed.
+void Scheduler::loadReplayLog() {
+    ifstream log(replayLogPath);
+    if (!log) {
+        cerr << "Warning: could not open replay log '" << replayLogPath << "'. Generating processes instead." << endl;
+        return;
+    }
 
-                int memSize = getRandomPowerOf2(minMemPerProc, maxMemPerProc);
+    string line;
+    while (getline(log, line)) {
+        stringstream ss(line);
+        if (line.rfind("# seed ", 0) == 0) {
+            string hash, word;
+            ss >> hash >> word >> runSeed;
+            seedConfigured = true;
+            continue;
+        }
 
-                auto instructions = generateInstructionsForProcess(screenName, memSize);
-                auto screen = make_shared<Screen>(screenName, instructions, CLIController::getInstance()->getTimestamp());
+        ArrivalRecord record;
+        string kind;
+        if (!(ss >> record.tick >> record.name >> record.memSize >> kind)) continue;
+        if (kind == "gen") {
+            ss >> record.programSeed;
+        }
+        else if (kind == "user") {
+            record.userProgram = true;
+            getline(ss >> std::ws, record.program);
+        }
+        else {
+            continue;
+        }
+        replayArrivals.push_back(record);
+    }
+}
 
-                MemoryManager::getInstance()->setupProcessMemory(screenName, memSize);
+// Creates every logged process whose arrival tick has been reached.
+void Scheduler::replayDueArrivals() {
+    while (replayIndex < replayArrivals.size() && replayArrivals[replayIndex].tick <= cpuCycles.load()) {
+        const auto& record = replayArrivals[replayIndex++];
+        if (ScreenManager::getInstance()->hasScreen(record.name)) continue;
 
-                ScreenManager::getInstance()->registerScreen(screenName, screen);
-                addProcessToQueue(screen);
+        vector<Instruction> instructions;
+        if (record.userProgram) {
+            try {
+                instructions = parseInstructions(record.program);
+            }
+            catch (const runtime_error& e) {
+                cerr << "Skipping replayed process '" << record.name << "': " << e.what() << endl;
+                continue;
             }
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        else {
+            instructions = generateInstructionsForProcess(record.name, record.memSize, record.programSeed);
+        }
+
+        auto screen = make_shared<Screen>(record.name, instructions, Clock::wallTime());
+        MemoryManager::getInstance()->setupProcessMemory(record.name, record.memSize, screen->getFaultCounters());
+        ScreenManager::getInstance()->registerScreen(record.name, screen);
+        if (record.userProgram) logArrival(record.name, record.memSize, record.program);
+        else logArrival(record.name, record.memSize, record.programSeed);
+        addProcessToQueue(screen);
     }
 }
 
-// Loads and parses configuration parameters from the "config.txt" file.
-void Scheduler::loadConfig() {
-    ifstream config("config.txt");
+// Loads and parses configuration parameters from a config file ("config.txt" by default).
+void Scheduler::loadConfig(const std::string& configPath) {
+    ifstream config(configPath);
     // Error checker
     if (!config) {
-        cerr << "Error: config.txt not found. Using default values." << endl;
+        cerr << "Error: " << configPath << " not found. Using default values." << endl;
         numCores = 2;
         algorithm = "rr";
         quantumCycles = 4;
@@ -342,13 +559,103 @@ void Scheduler::loadConfig() {
             maxMemPerProc = stoi(value);
             if (maxMemPerProc > 65536) maxMemPerProc = 65536;
         }
+        else if (key == "page-merge-ms") {
+            pageMergeIntervalMs = stoi(value);
+            if (pageMergeIntervalMs < 0) pageMergeIntervalMs = 0;
+        }
+        else if (key == "process-profiling") {
+            ProcessProfile::setEnabled(value == "1" || value == "true");
+        }
+        else if (key == "lock-profiling") {
+            ProfiledMutex::setProfilingEnabled(value == "1" || value == "true");
+        }
+        else if (key == "trace-events-per-core") {
+            traceEventsPerCore = stoi(value);
+            if (traceEventsPerCore < 1024) traceEventsPerCore = 1024;
+        }
+        else if (key == "seed") {
+            runSeed = stoull(value);
+            seedConfigured = true;
+        }
+        else if (key == "arrival-log") {
+            arrivalLogPath = value;
+        }
+        else if (key == "replay-log") {
+            replayLogPath = value;
+        }
+        else if (key == "address-pattern") {
+            if (!WorkloadConfig::parsePattern(value, workload.pattern)) {
+                workload.pattern = AddressPattern::UNIFORM; // Default value
+            }
+        }
+        else if (key == "address-stride") {
+            workload.stride = stoi(value);
+            if (workload.stride < 0) workload.stride = 0;
+        }
+        else if (key == "zipf-exponent") {
+            workload.zipfExponent = stod(value);
+            if (workload.zipfExponent < 0) workload.zipfExponent = 0;
+        }
+        else if (key == "working-set-pages") {
+            workload.workingSetPages = stoi(value);
+            if (workload.workingSetPages < 1) workload.workingSetPages = 1;
+        }
+        else if (key == "phase-length") {
+            workload.phaseLength = stoi(value);
+            if (workload.phaseLength < 1) workload.phaseLength = 1;
+        }
+        else if (key == "instruction-mix") {
+            if (!workload.parseInstructionMix(value)) {
+                cerr << "Warning: invalid instruction-mix '" << value << "'. Using the default mix." << endl;
+            }
+        }
+        else if (key == "print-log-capacity") {
+            int capacity = stoi(value);
+            if (capacity > 0) PrintLog::setDefaultCapacity(static_cast<size_t>(capacity));
+        }
+        else if (key == "report-format") {
+            ReportFormat format;
+            if (ReportWriter::parseFormat(value, format)) reporter.setFormat(format);
+            else cerr << "Unknown report-format '" << value << "'; using text." << endl;
+        }
+        else if (key == "report-interval-ticks") {
+            reporter.setIntervalTicks(stoi(value));
+        }
+        else if (key == "report-rotate") {
+            reporter.setRotateCount(stoi(value));
+        }
+        else if (key == "vmstat-history-ticks") {
+            int ticks = stoi(value);
+            if (ticks > 0) vmHistory.setCapacity(static_cast<size_t>(ticks));
+        }
+        else if (key == "metrics-interval-ticks") {
+            metrics.setIntervalTicks(stoi(value));
+        }
+        else if (key == "top-refresh-ms") {
+            topRefreshMs = max(50, stoi(value));
+        }
+        else if (key == "archive-finished") {
+            archiveFinished = (value == "1" || value == "true");
+        }
+        else if (key == "async-page-faults") {
+            asyncPageFaults = (value == "1" || value == "true");
+        }
+        else if (key == "compressed-swap-size") {
+            compressedSwapSize = stoi(value);
+            if (compressedSwapSize < 0) compressedSwapSize = 0;
+        }
     }
     // Assign cores available
     coresAvailable = numCores;
 }
 
+// Returns the number of cores currently running a process.
 int Scheduler::getUsedCores() const {
-    return coresUsed.load(); 
+    int used = 0;
+    for (int i = 0; i < numCores; ++i) {
+        if (coreSlots[i].busy.load(memory_order_relaxed)) used++;
+    }
+    return used;
 }
 int Scheduler::getAvailableCores() const { return coresAvailable; }
 int Scheduler::getCpuCycles() const {
@@ -360,6 +667,13 @@ void Scheduler::setCpuCycles(int cycles) {
     cpuCycles.store(cycles);
 }
 int Scheduler::getDelayPerExec() const { return delayPerExec; }
+bool Scheduler::getAsyncPageFaults() const { return asyncPageFaults; }
+int Scheduler::getBlockedProcessCount() const { return blockedProcesses.load(); }
+int Scheduler::getNumCores() const { return numCores; }
+long long Scheduler::getInstructionsExecuted() const { return instructionsExecuted.load(); }
+SchedulerEventTrace& Scheduler::getEventTrace() { return eventTrace; }
+ReportWriter& Scheduler::getReporter() { return reporter; }
+const VmStatHistory& Scheduler::getVmStatHistory() const { return vmHistory; }
 bool Scheduler::getSchedulerRunning() const { return schedulerRunning.load(); }
 void Scheduler::setSchedulerRunning(bool val) { schedulerRunning.store(val); }
 void Scheduler::setGeneratingProcesses(bool shouldGenerate) {
@@ -368,12 +682,44 @@ void Scheduler::setGeneratingProcesses(bool shouldGenerate) {
 bool Scheduler::getGeneratingProcesses() {
 	return generatingProcesses.load();
 }
+// Advances the CPU clock, charges the tick to each core as busy or idle and
+// records the tick's counters in the vmstat history.
 void Scheduler::incrementCpuCycles() {
-    cpuCycles.fetch_add(1); 
+    int tick = cpuCycles.fetch_add(1) + 1;
+    int busyCores = 0;
+    for (int i = 0; i < numCores; ++i) {
+        CoreSlot& slot = coreSlots[i];
+        if (slot.busy.load(memory_order_relaxed)) {
+            slot.busyTicks.fetch_add(1, memory_order_relaxed);
+            busyCores++;
+        }
+        else slot.idleTicks.fetch_add(1, memory_order_relaxed);
+    }
+
+    MemoryManager* memManager = MemoryManager::getInstance();
+    if (memManager) {
+        VmStatSample sample;
+        sample.tick = tick;
+        sample.nanos = Clock::monotonicNanos();
+        sample.instructions = instructionsExecuted.load();
+        sample.pagedIn = memManager->getPagedInCount();
+        sample.pagedOut = memManager->getPagedOutCount();
+        sample.faults = memManager->getMinorFaultCount() + memManager->getMajorFaultCount();
+        sample.usedFrames = memManager->getUsedFrameCount();
+        sample.readyProcesses = ScreenManager::getInstance()->getProcessCount(ProcessState::READY);
+        sample.blockedProcesses = blockedProcesses.load();
+        sample.busyCores = busyCores;
+        vmHistory.record(sample);
+    }
+    reporter.onTick(tick);
+    metrics.onTick(tick);
 }
 int Scheduler::getQuantumCycles() const {
     return quantumCycles;
 }
+int Scheduler::getTopRefreshMs() const {
+    return topRefreshMs;
+}
 
 // helper function to get a random power of 2 within a range (used primarily for min/max mem proc)
 int Scheduler::getRandomPowerOf2(int minVal, int maxVal) {
@@ -385,23 +731,72 @@ int Scheduler::getRandomPowerOf2(int minVal, int maxVal) {
     }
     if (powers.empty()) return minVal;
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // Memory sizes come from their own seeded stream, shared by the CLI and generator threads.
     std::uniform_int_distribution<> dist(0, static_cast<int>(powers.size() - 1));
-
-    return powers[dist(gen)];
+    lock_guard<mutex> lock(rngMutex);
+    return powers[dist(memSizeGen)];
 }
 
 
-void Scheduler::incrementIdleCpuTicks() {
-    idleCpuTicks.fetch_add(1);
+// Publishes the process a core is running, or clears it when process is null.
+// Only the core's own worker writes its slot.
+void Scheduler::publishCoreProcess(int core, const Screen* process) {
+    CoreSlot& slot = coreSlots[core];
+    uint64_t sequence = slot.processSequence.load(memory_order_relaxed);
+    slot.processSequence.store(sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    if (process) {
+        slot.processName.store(process->getName());
+        slot.processCpuTicks.store(process->getMetrics().cpuTicks, memory_order_relaxed);
+        slot.dispatchTick.store(cpuCycles.load(), memory_order_relaxed);
+    }
+    else {
+        slot.processName.store("");
+    }
+    slot.processSequence.store(sequence + 2, memory_order_release);
+}
+
+// Returns the state, counters and current process of one core without taking any lock.
+CoreStats Scheduler::getCoreStats(int core) const {
+    CoreStats stats;
+    const CoreSlot& slot = coreSlots[core];
+    stats.busy = slot.busy.load(memory_order_relaxed);
+    stats.busyTicks = slot.busyTicks.load(memory_order_relaxed);
+    stats.idleTicks = slot.idleTicks.load(memory_order_relaxed);
+    stats.instructions = slot.instructions.load(memory_order_relaxed);
+
+    char name[CORE_PROCESS_NAME_SIZE];
+    int cpuTicks = 0, dispatchTick = 0;
+    while (true) {
+        uint64_t before = slot.processSequence.load(memory_order_acquire);
+        if ((before & 1) == 0) {
+            slot.processName.copyTo(name);
+            cpuTicks = slot.processCpuTicks.load(memory_order_relaxed);
+            dispatchTick = slot.dispatchTick.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (slot.processSequence.load(memory_order_relaxed) == before) break;
+        }
+        this_thread::yield(); // the worker is mid-rewrite; let it finish
+    }
+    stats.process = name;
+    if (!stats.process.empty()) stats.processCpuTicks = cpuTicks + max(0, cpuCycles.load() - dispatchTick);
+    return stats;
 }
 
-int Scheduler::getIdleCpuTicks() const {
-    return idleCpuTicks.load();
+// Returns the tick counters summed over all cores; busy is true if any core is busy.
+CoreStats Scheduler::getAggregateCoreStats() const {
+    CoreStats total;
+    for (int i = 0; i < numCores; ++i) {
+        CoreStats core = getCoreStats(i);
+        total.busy = total.busy || core.busy;
+        total.busyTicks += core.busyTicks;
+        total.idleTicks += core.idleTicks;
+        total.instructions += core.instructions;
+    }
+    return total;
 }
 
 size_t Scheduler::getProcessQueueSize() const {
-    std::lock_guard<std::mutex> lock(processQueueMutex);
+    std::lock_guard<ProfiledMutex> lock(processQueueMutex);
     return processQueue.size();
 }
\ No newline at end of file
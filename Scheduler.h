@@ -8,16 +8,38 @@
 #include <atomic>
 #include "MemoryManager.h"
 #include "Screen.h"
+#include "ProcessRegistry.h"
+#include "WorkloadGenerator.h"
+#include "LatencyHistogram.h"
+#include "SchedulerEventTrace.h"
+#include "ReportWriter.h"
+#include "MetricsExporter.h"
+#include "VmStatHistory.h"
+#include "AtomicText.h"
 #include <vector>
+#include <random>
+#include <fstream>
 using namespace std;
 
 
+// Snapshot of one core's state and tick counters.
+struct CoreStats {
+	bool busy = false;
+	long long busyTicks = 0;
+	long long idleTicks = 0;
+	long long instructions = 0; // retired on this core
+	std::string process;        // process on the core, empty when idle
+	int processCpuTicks = 0;    // CPU ticks of that process, including its current run
+
+	double utilization() const { return busyTicks + idleTicks > 0 ? 100.0 * busyTicks / (busyTicks + idleTicks) : 0.0; }
+};
+
 class Scheduler {
 public:
 
 	// Singleton Access
 	static Scheduler* getInstance();
-	static void initialize();
+	static void initialize(const std::string& configPath = "config.txt");
 
 	// Process Queue Management
 	void addProcessToQueue(shared_ptr<Screen> screen);
@@ -25,7 +47,7 @@ public:
 	// Scheduler
 	void start();
 	void stop();
-	void loadConfig();
+	void loadConfig(const std::string& configPath = "config.txt");
 	bool getSchedulerRunning() const;
 	void setSchedulerRunning(bool val);
 
@@ -35,6 +57,10 @@ public:
 	int getCpuCycles() const;
 	void setCpuCycles(int cpuCycles);
 	int getDelayPerExec() const;
+	bool getAsyncPageFaults() const;
+	int getBlockedProcessCount() const;
+	int getNumCores() const;
+	long long getInstructionsExecuted() const;
 
 	// Algorithm Configuration
 	void setAlgorithm(const string& algo);
@@ -47,16 +73,35 @@ public:
 	bool getGeneratingProcesses();
 
 	std::vector<Instruction> generateInstructionsForProcess(const std::string& screenName, int processMemorySize);
+	std::vector<Instruction> generateInstructionsForProcess(const std::string& screenName, int processMemorySize, unsigned long long programSeed);
+
+	// Seeding, Arrival Log and Replay
+	unsigned long long getRunSeed() const;
+	unsigned long long getProgramSeed(const std::string& screenName) const;
+	bool isReplaying() const;
+	void logArrival(const std::string& screenName, int memSize, unsigned long long programSeed);
+	void logArrival(const std::string& screenName, int memSize, const std::string& program);
 	void startProcessGeneration();
+	shared_ptr<Screen> spawnGeneratedProcess();
 	void incrementCpuCycles();
 	int getQuantumCycles() const;
+	int getTopRefreshMs() const;
 
-	void incrementIdleCpuTicks();
-	int getIdleCpuTicks() const;
+	// Per-core Accounting
+	CoreStats getCoreStats(int core) const;
+	CoreStats getAggregateCoreStats() const;
+
+	// Event Tracing
+	SchedulerEventTrace& getEventTrace();
+	ReportWriter& getReporter();
+	const VmStatHistory& getVmStatHistory() const;
 	size_t getProcessQueueSize() const;
 
 private:
 	Scheduler();
+	void indexProcess(const shared_ptr<Screen>& process, ProcessState state);
+	void publishCoreProcess(int core, const Screen* process);
+	void retireProcess(const shared_ptr<Screen>& process);
 
 	// State & Config
 	int numCores;
@@ -70,19 +115,69 @@ private:
 	int memPerProc = 4096;
 	int minMemPerProc = 64;
 	int maxMemPerProc = 65536;
+	int pageMergeIntervalMs = 0; // 0 disables same-page merging
+	int compressedSwapSize = 0;  // bytes; 0 disables the compressed swap tier
+	bool asyncPageFaults = false; // park faulting processes instead of faulting on the core
+	bool archiveFinished = true;  // compact finished processes and move their logs to disk
+	int topRefreshMs = 500;       // redraw interval of the 'top' dashboard
+	WorkloadConfig workload;      // address pattern and instruction mix of generated processes
 	atomic<bool> schedulerRunning{ false };
 
 	// Metrics
-	std::atomic<int> coresUsed = 0;
+	// One slot per core on its own cache line: the core's worker sets busy, and the
+	// tick thread samples every slot once per CPU cycle. The worker also publishes the
+	// process it runs under a sequence lock, so 'top' can show it without any lock.
+	static const size_t CORE_PROCESS_NAME_SIZE = 24;
+	struct alignas(64) CoreSlot {
+		std::atomic<bool> busy{ false };
+		std::atomic<long long> busyTicks{ 0 };
+		std::atomic<long long> idleTicks{ 0 };
+		std::atomic<long long> instructions{ 0 };
+		std::atomic<uint64_t> processSequence{ 0 }; // odd while the process fields are rewritten
+		AtomicText<CORE_PROCESS_NAME_SIZE> processName;
+		std::atomic<int> processCpuTicks{ 0 };      // CPU ticks of the process when dispatched
+		std::atomic<int> dispatchTick{ 0 };
+	};
+	std::unique_ptr<CoreSlot[]> coreSlots;
+	SchedulerEventTrace eventTrace;
+	ReportWriter reporter;
+	MetricsExporter metrics;
+	VmStatHistory vmHistory;
+	int traceEventsPerCore = static_cast<int>(SchedulerEventTrace::DEFAULT_EVENTS_PER_CORE);
 	int coresAvailable;
 	std::atomic<int> cpuCycles = 0;
+	std::atomic<int> blockedProcesses{ 0 };
+	std::atomic<long long> instructionsExecuted{ 0 };
 
 	// Process Generation
 	thread processGeneratorThread;
 	int generationIntervalTicks = 5;
 	int lastGenCycle = 0;
 	int generatedProcessCount = 0;
-	
+
+	// Random Streams and Replay
+	struct ArrivalRecord {
+		int tick = 0;
+		string name;
+		int memSize = 0;
+		bool userProgram = false;
+		unsigned long long programSeed = 0;
+		string program;
+	};
+	unsigned long long runSeed = 0;
+	bool seedConfigured = false;
+	std::mt19937 memSizeGen;
+	mutable std::mutex rngMutex;
+	string arrivalLogPath;
+	string replayLogPath;
+	std::ofstream arrivalLog;
+	std::mutex arrivalLogMutex;
+	vector<ArrivalRecord> replayArrivals;
+	size_t replayIndex = 0;
+	void seedRandomStreams();
+	void loadReplayLog();
+	void replayDueArrivals();
+	static unsigned long long mixSeed(unsigned long long seed, unsigned long long stream);
 
 	// Singleton
 	static Scheduler* scheduler;
@@ -92,10 +187,9 @@ private:
 	void generateDummyProcesses();
 
 	// Queues & Threads
-	std::atomic<int> idleCpuTicks{ 0 };
 	std::queue<std::shared_ptr<Screen>> processQueue;
-	mutable std::mutex processQueueMutex;
-	condition_variable processQueueCondition;
+	mutable ProfiledMutex processQueueMutex{ "Scheduler::processQueueMutex" };
+	condition_variable_any processQueueCondition;
 	int activeThreads;
 	vector<thread> workerThreads;
 };
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "SchedulerEventTrace.h"
+#include "Clock.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+using namespace std;
+
+// Sizes one ring per core, rounding the capacity up to a power of two.
+void SchedulerEventTrace::allocate(int numCores, size_t eventsPerCore) {
+    capacity = 1;
+    while (capacity < eventsPerCore) capacity <<= 1;
+    numRings = numCores;
+    rings.reset(new Ring[numRings]);
+    for (int i = 0; i < numRings; ++i) {
+        rings[i].slots.reset(new Slot[capacity]);
+    }
+}
+
+// Starts recording. Only events from this point on are exported.
+void SchedulerEventTrace::start() {
+    if (!rings) return;
+    startNanos.store(Clock::monotonicNanos());
+    enabled.store(true);
+}
+
+// Stops recording; the rings keep their events for export.
+void SchedulerEventTrace::stop() {
+    enabled.store(false);
+}
+
+// Writes an event into the core's ring. Called only from that core's worker thread.
+void SchedulerEventTrace::append(int core, SchedulerEventType type, const string& process, int tick, int arg) {
+    if (core < 0 || core >= numRings) return;
+    Ring& ring = rings[core];
+    uint64_t index = ring.head.load(memory_order_relaxed);
+    Slot& slot = ring.slots[index & (capacity - 1)];
+
+    slot.sequence.store(2 * index + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot.event.nanos = Clock::monotonicNanos();
+    slot.event.tick = tick;
+    slot.event.arg = arg;
+    slot.event.core = static_cast<int16_t>(core);
+    slot.event.type = type;
+    strncpy(slot.event.process, process.c_str(), sizeof(slot.event.process) - 1);
+    slot.event.process[sizeof(slot.event.process) - 1] = '\0';
+    slot.sequence.store(2 * index + 2, memory_order_release);
+    ring.head.store(index + 1, memory_order_release);
+}
+
+// Copies the events recorded since start() out of every ring, ordered by time.
+vector<SchedulerEvent> SchedulerEventTrace::snapshot() const {
+    vector<SchedulerEvent> events;
+    long long since = startNanos.load();
+    for (int r = 0; r < numRings; ++r) {
+        const Ring& ring = rings[r];
+        uint64_t head = ring.head.load(memory_order_acquire);
+        uint64_t first = head > capacity ? head - capacity : 0;
+        for (uint64_t index = first; index < head; ++index) {
+            const Slot& slot = ring.slots[index & (capacity - 1)];
+            uint64_t before = slot.sequence.load(memory_order_acquire);
+            if (before != 2 * index + 2) continue; // overwritten or still being written
+            SchedulerEvent event = slot.event;
+            atomic_thread_fence(memory_order_acquire);
+            if (slot.sequence.load(memory_order_relaxed) != before) continue;
+            if (event.nanos >= since) events.push_back(event);
+        }
+    }
+    sort(events.begin(), events.end(), [](const SchedulerEvent& a, const SchedulerEvent& b) { return a.nanos < b.nanos; });
+    return events;
+}
+
+// Returns the total number of events written to the rings.
+long long SchedulerEventTrace::getRecordedCount() const {
+    long long total = 0;
+    for (int r = 0; r < numRings; ++r) total += static_cast<long long>(rings[r].head.load());
+    return total;
+}
+
+// Returns the number of events lost because a ring wrapped around.
+long long SchedulerEventTrace::getOverwrittenCount() const {
+    long long total = 0;
+    for (int r = 0; r < numRings; ++r) {
+        uint64_t head = rings[r].head.load();
+        if (head > capacity) total += static_cast<long long>(head - capacity);
+    }
+    return total;
+}
+
+// Writes the trace as Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev).
+// Each core is a thread; a dispatch and the following preempt/finish on the same core
+// become one slice named after the process, and the other events become instants.
+bool SchedulerEventTrace::exportChromeTrace(const string& path) const {
+    ofstream out(path, ios::trunc);
+    if (!out) return false;
+
+    vector<SchedulerEvent> events = snapshot();
+    long long origin = startNanos.load();
+    auto micros = [origin](long long nanos) { return (nanos - origin) / 1000.0; };
+    static const char* instantNames[] = { "dispatch", "preempt", "finish", "sleep", "page-fault", "violation" };
+
+    out << fixed << setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    auto separator = [&]() -> ostream& {
+        if (!first) out << ",\n";
+        first = false;
+        return out;
+    };
+
+    for (int core = 0; core < numRings; ++core) {
+        separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << core
+            << ", \"args\": {\"name\": \"Core " << core << "\"}}";
+    }
+
+    vector<const SchedulerEvent*> openSlice(numRings, nullptr);
+    for (const auto& event : events) {
+        switch (event.type) {
+        case SchedulerEventType::DISPATCH:
+            openSlice[event.core] = &event;
+            break;
+        case SchedulerEventType::PREEMPT:
+        case SchedulerEventType::FINISH: {
+            const SchedulerEvent* start = openSlice[event.core];
+            openSlice[event.core] = nullptr;
+            if (!start || strcmp(start->process, event.process) != 0) break;
+            const char* reason = event.type == SchedulerEventType::FINISH
+                ? (event.arg ? "violation" : "finished")
+                : (event.arg ? "page-fault" : "quantum");
+            separator() << "{\"name\": \"" << event.process << "\", \"cat\": \"run\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.core
+                << ", \"ts\": " << micros(start->nanos) << ", \"dur\": " << (event.nanos - start->nanos) / 1000.0
+                << ", \"args\": {\"startTick\": " << start->tick << ", \"endTick\": " << event.tick
+                << ", \"end\": \"" << reason << "\"}}";
+            break;
+        }
+        default:
+            separator() << "{\"name\": \"" << instantNames[static_cast<int>(event.type)] << "\", \"cat\": \"event\", \"ph\": \"i\", \"s\": \"t\""
+                << ", \"pid\": 1, \"tid\": " << event.core << ", \"ts\": " << micros(event.nanos)
+                << ", \"args\": {\"process\": \"" << event.process << "\", \"tick\": " << event.tick << ", \"arg\": " << event.arg << "}}";
+            break;
+        }
+    }
+    out << "\n]}\n";
+    return out.good();
+}
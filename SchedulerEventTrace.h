@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Kinds of scheduler events recorded by SchedulerEventTrace.
+enum class SchedulerEventType : uint8_t {
+    DISPATCH,   // a core picked the process up
+    PREEMPT,    // the process left its core unfinished (arg 1 = parked on a page fault)
+    FINISH,     // the process completed (arg 1 = ended by a memory violation)
+    SLEEP,      // SLEEP instruction (arg = milliseconds)
+    PAGE_FAULT, // the next instruction touched non-resident pages (arg = page count)
+    VIOLATION   // memory access violation (arg = address)
+};
+
+struct SchedulerEvent {
+    long long nanos; // steady clock
+    int tick;        // scheduler CPU cycle
+    int arg;
+    int16_t core;
+    SchedulerEventType type;
+    char process[17];
+};
+
+// Per-core ring buffers of scheduler events, exported as Chrome trace-event JSON.
+// Each ring has a single producer, the worker thread of its core, and overwrites its
+// oldest events when full. Readers use per-slot sequence numbers to skip slots that
+// are being overwritten. While tracing is off, record() costs one relaxed load.
+class SchedulerEventTrace {
+public:
+    static const size_t DEFAULT_EVENTS_PER_CORE = 16384;
+
+    // Setup (before the workers start)
+    void allocate(int numCores, size_t eventsPerCore);
+
+    // Control
+    void start();
+    void stop();
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Recording
+    void record(int core, SchedulerEventType type, const std::string& process, int tick, int arg = 0) {
+        if (isEnabled()) append(core, type, process, tick, arg);
+    }
+
+    // Export
+    std::vector<SchedulerEvent> snapshot() const;
+    bool exportChromeTrace(const std::string& path) const;
+    long long getRecordedCount() const;
+    long long getOverwrittenCount() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{ 0 }; // odd while being written
+        SchedulerEvent event;
+    };
+    struct Ring {
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<uint64_t> head{ 0 };
+    };
+
+    void append(int core, SchedulerEventType type, const std::string& process, int tick, int arg);
+
+    std::atomic<bool> enabled{ false };
+    std::unique_ptr<Ring[]> rings;
+    int numRings = 0;
+    size_t capacity = 0; // power of two
+    std::atomic<long long> startNanos{ 0 };
+};
@@ -1,5 +1,6 @@
 #include "Screen.h"
 #include "CLIController.h"
+#include "Clock.h"
 #include "Scheduler.h"
 #include "MemoryManager.h" // Ensure MemoryManager is included for its functions
 #include <fstream>
@@ -14,14 +15,24 @@
 
 // Default constructor for creating placeholder screens (like 'main')
 Screen::Screen()
-    : name(""), instructions({}), timestamp(CLIController::getInstance()->getTimestamp()),
-    programCounter(0), cpuCoreID(-1), isRunning(false), memoryViolationOccurred(false), next_variable_offset(0) {
+    : memoryViolationOccurred(false), memoryViolationTime(0), name(""), instructions({}), totalInstructions(0),
+    createdTime(Clock::wallTime()), programCounter(0), cpuCoreID(-1), finishedTime(0), isRunning(false),
+    blockedOnPageFault(false), skipResidencyCheck(false), next_variable_offset(0),
+    faultCounters(std::make_shared<ProcessFaultCounters>()) {
 }
 
-// Constructor for creating a new process with a name, instructions, and creation timestamp.
-Screen::Screen(std::string name, std::vector<Instruction> instructions, std::string timestamp)
-    : name(name), instructions(instructions), timestamp(timestamp), programCounter(0),
-    cpuCoreID(-1), isRunning(false), memoryViolationOccurred(false), next_variable_offset(0) {
+// Constructor for creating a new process with a name, instructions, and creation time.
+Screen::Screen(std::string name, std::vector<Instruction> instructions, std::time_t createdTime)
+    : memoryViolationOccurred(false), memoryViolationTime(0), name(name), instructions(instructions),
+    totalInstructions(static_cast<int>(this->instructions.size())), createdTime(createdTime), programCounter(0),
+    cpuCoreID(-1), finishedTime(0), isRunning(false),
+    blockedOnPageFault(false), skipResidencyCheck(false), next_variable_offset(0),
+    faultCounters(std::make_shared<ProcessFaultCounters>()) {
+    createdNanos = Clock::monotonicNanos();
+}
+
+Screen::~Screen() {
+    delete profile.load();
 }
 
 
@@ -29,11 +40,141 @@ Screen::Screen(std::string name, std::vector<Instruction> instructions, std::str
 
 std::string Screen::getName() const { return name; }
 int Screen::getProgramCounter() const { return programCounter; }
-int Screen::getTotalInstructions() const { return static_cast<int>(instructions.size()); }
-std::string Screen::getTimestamp() const { return timestamp; }
-std::string Screen::getTimestampFinished() const { return timestampFinished; }
+int Screen::getTotalInstructions() const { return totalInstructions; }
+std::string Screen::getTimestamp() const { return Clock::format(createdTime); }
+std::string Screen::getTimestampFinished() const { return finishedTime ? Clock::format(finishedTime) : ""; }
+std::time_t Screen::getCreatedTime() const { return createdTime; }
+std::time_t Screen::getFinishedTime() const { return finishedTime; }
 int Screen::getCoreID() const { return cpuCoreID; }
 bool Screen::getIsRunning() const { return isRunning; }
+bool Screen::isBlockedOnPageFault() const { return blockedOnPageFault; }
+
+// Returns the state name used by the CSV and JSON reports and the metrics export.
+const char* Screen::getStateName() const {
+    if (hasMemoryViolation()) return "violated";
+    if (isFinished()) return "finished";
+    if (isBlockedOnPageFault()) return "blocked";
+    if (getIsRunning()) return "running";
+    return "ready";
+}
+std::vector<int> Screen::getPendingPages() const { return pendingPages; }
+std::shared_ptr<ProcessFaultCounters> Screen::getFaultCounters() const { return faultCounters; }
+ProcessFaultStats Screen::getFaultStats() const { return faultCounters->load(); }
+long long Screen::getCreatedNanos() const { return createdNanos.load(); }
+long long Screen::getFirstDispatchNanos() const { return firstDispatchNanos.load(); }
+long long Screen::getFinishedNanos() const { return finishedNanos.load(); }
+long long Screen::getCpuNanos() const { return cpuNanos.load(); }
+
+// Scheduling metrics
+
+// Records that the process entered the ready queue. The first call is its arrival.
+void Screen::markReady(int tick) {
+    int unset = -1;
+    arrivalTick.compare_exchange_strong(unset, tick);
+    readySinceTick.store(tick, std::memory_order_relaxed);
+}
+
+// Records that a core picked the process up, charging the time since markReady as ready-queue wait.
+void Screen::markDispatched(int tick) {
+    dispatchCount.fetch_add(1, std::memory_order_relaxed);
+    int unset = -1;
+    firstDispatchTick.compare_exchange_strong(unset, tick);
+    int readySince = readySinceTick.exchange(-1, std::memory_order_relaxed);
+    if (readySince >= 0) readyWaitTicks.fetch_add(tick - readySince, std::memory_order_relaxed);
+    dispatchedAtTick.store(tick, std::memory_order_relaxed);
+}
+
+// Records that the process left its core, charging the time since markDispatched as CPU time.
+void Screen::markDescheduled(int tick) {
+    int dispatchedAt = dispatchedAtTick.exchange(-1, std::memory_order_relaxed);
+    if (dispatchedAt >= 0) cpuTicks.fetch_add(tick - dispatchedAt, std::memory_order_relaxed);
+}
+
+// Records that the process was parked on a page fault.
+void Screen::markBlocked(int tick) {
+    blockedSinceTick.store(tick, std::memory_order_relaxed);
+}
+
+// Records that the pager released the process, charging the time since markBlocked as blocked time.
+void Screen::markUnblocked(int tick) {
+    int blockedSince = blockedSinceTick.exchange(-1, std::memory_order_relaxed);
+    if (blockedSince >= 0) blockedTicks.fetch_add(tick - blockedSince, std::memory_order_relaxed);
+}
+
+// Records the completion tick; only the first call counts.
+void Screen::markCompleted(int tick) {
+    int unset = -1;
+    completionTick.compare_exchange_strong(unset, tick);
+}
+
+// Returns a snapshot of the scheduling metrics.
+ProcessMetrics Screen::getMetrics() const {
+    ProcessMetrics metrics;
+    metrics.arrivalTick = arrivalTick.load();
+    metrics.firstDispatchTick = firstDispatchTick.load();
+    metrics.completionTick = completionTick.load();
+    metrics.cpuTicks = cpuTicks.load();
+    metrics.readyWaitTicks = readyWaitTicks.load();
+    metrics.blockedTicks = blockedTicks.load();
+    metrics.dispatchCount = dispatchCount.load();
+    return metrics;
+}
+
+// Instruction profile
+
+// Charges the ticks that passed since the last sample to the instruction that was executing.
+void Screen::chargeProfileSamples() {
+    int tick = Scheduler::getInstance()->getCpuCycles();
+    if (lastSampledSite && tick > lastSampleTick) {
+        activeProfile->recordSamples(lastSampledSite, tick - lastSampleTick);
+    }
+    lastSampleTick = tick;
+}
+
+// Samples the clock and counts the execution and page faults of an instruction about to run.
+void Screen::profileInstruction(const Instruction& instruction) {
+    chargeProfileSamples();
+    lastSampledSite = &instruction;
+
+    // A FOR's own pages are counted on the instructions in its body.
+    int faultedPages = 0;
+    if (instruction.type != InstructionType::FOR) {
+        std::vector<uint16_t> addresses;
+        collectPageAddresses(instruction, addresses);
+        faultedPages = static_cast<int>(MemoryManager::getInstance()->getMissingPages(name, addresses).size());
+    }
+    activeProfile->recordExecution(&instruction, faultedPages);
+}
+
+bool Screen::hasProfile() const {
+    return profile.load() != nullptr;
+}
+
+// Returns every instruction of the program in order, with FOR bodies nested, and its profile counts.
+std::vector<Screen::ProfileSite> Screen::getProfileSites() const {
+    std::vector<ProfileSite> sites;
+    ProcessProfile* current = profile.load();
+    if (!current) return sites;
+    collectProfileSites(instructions, "", 0, current->getCounts(), sites);
+    return sites;
+}
+
+void Screen::collectProfileSites(const std::vector<Instruction>& list, const std::string& prefix, int depth,
+    const std::unordered_map<const Instruction*, ProcessProfile::SiteCounts>& counts, std::vector<ProfileSite>& sites) const {
+    for (size_t i = 0; i < list.size(); ++i) {
+        const Instruction& instruction = list[i];
+        ProfileSite site;
+        site.position = prefix + std::to_string(i);
+        site.depth = depth;
+        site.source = ProcessProfile::describe(instruction);
+        auto it = counts.find(&instruction);
+        if (it != counts.end()) site.counts = it->second;
+        sites.push_back(site);
+        if (instruction.type == InstructionType::FOR) {
+            collectProfileSites(instruction.innerInstructions, site.position + ".", depth + 1, counts, sites);
+        }
+    }
+}
 
 bool Screen::isFinished() const {
     // A process is finished if its PC is past the end or a memory violation occurred.
@@ -41,8 +182,52 @@ bool Screen::isFinished() const {
 }
 
 std::vector<std::string> Screen::getOutputBuffer() const {
-    std::lock_guard<std::mutex> lock(outputMutex);
-    return outputBuffer;
+    ProcessArchive* store;
+    std::vector<std::string> lines;
+    {
+        std::lock_guard<ProfiledMutex> lock(outputMutex);
+        store = archivedTo.load();
+        if (!store) lines = formatOutputLocked();
+    }
+    if (store) return store->read(name);
+    return lines;
+}
+
+// Formats the PRINT log. The caller holds outputMutex: records point into the program,
+// which archive() frees under the same lock.
+std::vector<std::string> Screen::formatOutputLocked() const {
+    std::vector<std::string> lines;
+    lines.reserve(outputBuffer.size());
+    for (const auto& record : outputBuffer.snapshot()) lines.push_back(PrintLog::format(record));
+    return lines;
+}
+
+// Returns the number of PRINT lines overwritten because the log was full.
+long long Screen::getDroppedOutputCount() const {
+    std::lock_guard<ProfiledMutex> lock(outputMutex);
+    return outputBuffer.getDroppedCount();
+}
+
+// Archival of finished processes
+
+// Moves the log of a finished process to the archive and frees its log, symbol table and
+// program. The program is kept while an instruction profile refers to it.
+bool Screen::archive(ProcessArchive& store) {
+    if (!isFinished()) return false;
+    std::lock_guard<ProfiledMutex> lock(outputMutex);
+    if (archivedTo.load()) return false;
+    if (!store.append(name, formatOutputLocked())) return false;
+    archivedTo.store(&store);
+    outputBuffer.clear();
+
+    std::map<std::string, uint16_t>().swap(variable_offsets);
+    std::vector<int>().swap(pendingPages);
+    if (!profile.load()) std::vector<Instruction>().swap(instructions);
+    return true;
+}
+
+bool Screen::isArchived() const {
+    return archivedTo.load() != nullptr;
 }
 
 bool Screen::hasMemoryViolation() const {
@@ -54,18 +239,32 @@ std::string Screen::getMemoryViolationAddress() const {
 }
 
 std::string Screen::getMemoryViolationTime() const {
-    return memoryViolationTime;
+    return memoryViolationOccurred ? Clock::format(memoryViolationTime) : "";
 }
 
 // Setters
 
 void Screen::setCoreID(int id) { cpuCoreID = id; }
 void Screen::setIsRunning(bool running) { isRunning = running; }
+void Screen::setBlockedOnPageFault(bool blocked) { blockedOnPageFault = blocked; }
 
 // Executes the process's instructions for a given number of cycles (quantum).
-void Screen::execute(int quantum) {
-    if (isFinished()) return;
+ExecutionStatus Screen::execute(int quantum) {
+    if (isFinished()) return ExecutionStatus::RAN;
+    long long dispatchedAt = Clock::monotonicNanos();
+    if (firstDispatchNanos == 0) firstDispatchNanos = dispatchedAt;
     setIsRunning(true);
+    setBlockedOnPageFault(false);
+    bool asyncFaults = Scheduler::getInstance()->getAsyncPageFaults();
+    SchedulerEventTrace& trace = Scheduler::getInstance()->getEventTrace();
+
+    activeProfile = nullptr;
+    if (ProcessProfile::isEnabled()) {
+        if (!profile.load()) profile.store(new ProcessProfile());
+        activeProfile = profile.load();
+        lastSampledSite = nullptr;
+        lastSampleTick = Scheduler::getInstance()->getCpuCycles();
+    }
 
     int instructionsToExecute = (quantum == -1) ? (getTotalInstructions() - programCounter) : quantum;
 
@@ -75,28 +274,58 @@ void Screen::execute(int quantum) {
         }
         const auto& instruction = instructions[programCounter];
 
+        // Block instead of faulting on the core if the instruction touches non-resident pages.
+        // While tracing, the same check also reports the faults taken on the core.
+        bool checkResidency = asyncFaults && !skipResidencyCheck;
+        if (checkResidency || trace.isEnabled()) {
+            std::vector<uint16_t> addresses;
+            collectPageAddresses(instruction, addresses);
+            std::vector<int> missingPages = MemoryManager::getInstance()->getMissingPages(name, addresses);
+            if (!missingPages.empty()) {
+                trace.record(cpuCoreID, SchedulerEventType::PAGE_FAULT, name, Scheduler::getInstance()->getCpuCycles(),
+                    static_cast<int>(missingPages.size()));
+            }
+            if (checkResidency && !missingPages.empty()) {
+                pendingPages = missingPages;
+                skipResidencyCheck = true;
+                setBlockedOnPageFault(true);
+                setIsRunning(false);
+                if (activeProfile) chargeProfileSamples();
+                cpuNanos += Clock::monotonicNanos() - dispatchedAt;
+                return ExecutionStatus::BLOCKED_ON_PAGE_FAULT;
+            }
+        }
+        skipResidencyCheck = false;
+
         int delay = Scheduler::getInstance()->getDelayPerExec();
         if (delay > 0) {
             for (volatile int d = 0; d < delay; ++d) { /* busy-wait */ }
         }
 
-        executeInstructionList({ instruction });
+        executeInstruction(instruction);
 
         programCounter++;
     }
 
     // Check if finished *after* the loop
     if (programCounter >= getTotalInstructions() && !hasMemoryViolation()) {
-        setTimestampFinished(CLIController::getInstance()->getTimestamp());
+        setFinishedTime(Clock::wallTime());
         setIsRunning(false);
     }
+    if (activeProfile) chargeProfileSamples();
+    long long returnedAt = Clock::monotonicNanos();
+    cpuNanos += returnedAt - dispatchedAt;
+    if (isFinished() && finishedNanos == 0) finishedNanos = returnedAt;
+    return ExecutionStatus::RAN;
 }
 
 // Private Helper Methods
 
-void Screen::addOutput(const std::string& message) {
-    std::lock_guard<std::mutex> lock(outputMutex);
-    outputBuffer.push_back(message);
+// Logs a PRINT as a binary record; the line is formatted only when displayed.
+void Screen::addOutput(const Instruction& print, uint16_t value) {
+    PrintLog::Record record{ &print, Clock::wallTime(), Scheduler::getInstance()->getCpuCycles(), value, static_cast<int16_t>(cpuCoreID) };
+    std::lock_guard<ProfiledMutex> lock(outputMutex);
+    outputBuffer.append(record);
 }
 
 // Check if there is space for a new variable in the 64-byte symbol table.
@@ -107,7 +336,6 @@ bool Screen::canDeclareVariable() const {
 
 uint16_t Screen::getOperandValue(const Operand& op) {
     if (op.isVariable) {
-        ensureSymbolTableLoaded();
         if (hasMemoryViolation()) return 0;
 
         if (variable_offsets.find(op.variableName) == variable_offsets.end()) {
@@ -127,7 +355,6 @@ uint16_t Screen::getOperandValue(const Operand& op) {
 }
 
 void Screen::setVariableValue(const std::string& name, uint16_t value) {
-    ensureSymbolTableLoaded();
     if (hasMemoryViolation()) return;
 
     uint16_t address;
@@ -154,75 +381,74 @@ void Screen::setVariableValue(const std::string& name, uint16_t value) {
 void Screen::executeInstructionList(const std::vector<Instruction>& instructionList) {
     for (const auto& instruction : instructionList) {
         if (hasMemoryViolation()) return;
+        executeInstruction(instruction);
+    }
+}
 
-        int delay = Scheduler::getInstance()->getDelayPerExec();
-        if (delay > 0) {
-            for (volatile int d = 0; d < delay; ++d) { /* busy-wait */ }
-        }
+// Executes one instruction in place, so nested FOR bodies are never copied.
+void Screen::executeInstruction(const Instruction& instruction) {
+    int delay = Scheduler::getInstance()->getDelayPerExec();
+    if (delay > 0) {
+        for (volatile int d = 0; d < delay; ++d) { /* busy-wait */ }
+    }
+    if (activeProfile) profileInstruction(instruction);
 
-        switch (instruction.type) {
-        case InstructionType::DECLARE:
-            if (canDeclareVariable()) {
-                setVariableValue(instruction.operands[0].variableName, getOperandValue(instruction.operands[1]));
-            }
-            break;
-        case InstructionType::ADD:
-            setVariableValue(instruction.operands[0].variableName, getOperandValue(instruction.operands[1]) + getOperandValue(instruction.operands[2]));
-            break;
-        case InstructionType::SUBTRACT:
-            setVariableValue(instruction.operands[0].variableName, getOperandValue(instruction.operands[1]) - getOperandValue(instruction.operands[2]));
-            break;
-        case InstructionType::PRINT: {
-            std::string output = instruction.printMessage;
-            if (!instruction.operands.empty() && instruction.operands[0].isVariable) {
-                const auto& varName = instruction.operands[0].variableName;
-                std::string placeholder = "%" + varName + "%";
-                size_t pos = output.find(placeholder);
-                if (pos != std::string::npos) {
-                    output.replace(pos, placeholder.length(), std::to_string(getOperandValue(instruction.operands[0])));
-                }
-            }
-            std::string timestamp = CLIController::getInstance()->getTimestamp();
-            std::string formattedLog = "(" + timestamp + ") Core:" + std::to_string(cpuCoreID) + " \"" + output + "\"";
-            addOutput(formattedLog);
-            break;
+    switch (instruction.type) {
+    case InstructionType::DECLARE:
+        if (canDeclareVariable()) {
+            setVariableValue(instruction.operands[0].variableName, getOperandValue(instruction.operands[1]));
         }
-        case InstructionType::READ: {
-            uint16_t address = instruction.memoryAddress;
-            uint16_t value;
-            if (MemoryManager::getInstance()->readMemory(name, address, value)) {
-                // Check if we can declare a new variable OR if it already exists in the correct map.
-                if (canDeclareVariable() || variable_offsets.count(instruction.operands[0].variableName)) {
-                    setVariableValue(instruction.operands[0].variableName, value);
-                }
-            }
-            else {
-                triggerMemoryViolation(address);
-                return;
+        break;
+    case InstructionType::ADD:
+        setVariableValue(instruction.operands[0].variableName, getOperandValue(instruction.operands[1]) + getOperandValue(instruction.operands[2]));
+        break;
+    case InstructionType::SUBTRACT:
+        setVariableValue(instruction.operands[0].variableName, getOperandValue(instruction.operands[1]) - getOperandValue(instruction.operands[2]));
+        break;
+    case InstructionType::PRINT: {
+        uint16_t value = PrintLog::hasPlaceholder(instruction) ? getOperandValue(instruction.operands[0]) : 0;
+        addOutput(instruction, value);
+        break;
+    }
+    case InstructionType::READ: {
+        uint16_t address = instruction.memoryAddress;
+        uint16_t value;
+        if (MemoryManager::getInstance()->readMemory(name, address, value)) {
+            // Check if we can declare a new variable OR if it already exists in the correct map.
+            if (canDeclareVariable() || variable_offsets.count(instruction.operands[0].variableName)) {
+                setVariableValue(instruction.operands[0].variableName, value);
             }
-            break;
         }
-        case InstructionType::WRITE: {
-            uint16_t address = instruction.memoryAddress;
-            uint16_t value = getOperandValue(instruction.operands[0]);
-            if (!MemoryManager::getInstance()->writeMemory(name, address, value)) {
-                triggerMemoryViolation(address);
-                return;
-            }
-            break;
+        else {
+            triggerMemoryViolation(address);
+            return;
         }
-        case InstructionType::SLEEP:
-            std::this_thread::sleep_for(std::chrono::milliseconds(getOperandValue(instruction.operands[0])));
-            break;
-        case InstructionType::FOR: {
-            uint16_t repeats = getOperandValue(instruction.operands[0]);
-            for (uint16_t i = 0; i < repeats; ++i) {
-                if (hasMemoryViolation()) break; // Check for violation inside the loop
-                executeInstructionList(instruction.innerInstructions);
-            }
-            break;
+        break;
+    }
+    case InstructionType::WRITE: {
+        uint16_t address = instruction.memoryAddress;
+        uint16_t value = getOperandValue(instruction.operands[0]);
+        if (!MemoryManager::getInstance()->writeMemory(name, address, value)) {
+            triggerMemoryViolation(address);
+            return;
         }
+        break;
+    }
+    case InstructionType::SLEEP: {
+        uint16_t sleepMs = getOperandValue(instruction.operands[0]);
+        Scheduler::getInstance()->getEventTrace().record(cpuCoreID, SchedulerEventType::SLEEP, name,
+            Scheduler::getInstance()->getCpuCycles(), sleepMs);
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+        break;
+    }
+    case InstructionType::FOR: {
+        uint16_t repeats = getOperandValue(instruction.operands[0]);
+        for (uint16_t i = 0; i < repeats; ++i) {
+            if (hasMemoryViolation()) break; // Check for violation inside the loop
+            executeInstructionList(instruction.innerInstructions);
         }
+        break;
+    }
     }
 }
 
@@ -232,30 +458,35 @@ void Screen::triggerMemoryViolation(uint16_t address) {
     std::stringstream ss;
     ss << "0x" << std::hex << std::uppercase << address;
     memoryViolationAddress = ss.str();
-    memoryViolationTime = CLIController::getInstance()->getTimestamp();
+    memoryViolationTime = Clock::wallTime();
     memoryViolationOccurred = true;
-    setTimestampFinished(memoryViolationTime); // A memory violation also "finishes" the process
+    setFinishedTime(memoryViolationTime); // A memory violation also "finishes" the process
+    Scheduler::getInstance()->getEventTrace().record(cpuCoreID, SchedulerEventType::VIOLATION, name,
+        Scheduler::getInstance()->getCpuCycles(), address);
     setIsRunning(false);
 }
 
-void Screen::ensureSymbolTableLoaded() {
-    if (hasMemoryViolation()) return;
+// Gathers one address per page the instruction may touch: the symbol table for variables,
+// plus the target address of READ/WRITE, including everything nested in a FOR.
+void Screen::collectPageAddresses(const Instruction& instruction, std::vector<uint16_t>& addresses) const {
+    bool usesSymbolTable = instruction.type == InstructionType::DECLARE || instruction.type == InstructionType::ADD ||
+        instruction.type == InstructionType::SUBTRACT || instruction.type == InstructionType::READ;
+    for (const auto& operand : instruction.operands) {
+        if (operand.isVariable) usesSymbolTable = true;
+    }
+    if (usesSymbolTable) addresses.push_back(0x0);
 
-    // Reading from address 0x0 forces the MemoryManager to load the first page
-    // of the process (the symbol table) if it's not already present.
-    uint16_t dummy_value;
-    if (!MemoryManager::getInstance()->readMemory(name, 0x0, dummy_value)) {
-        // This will trigger a page fault handled by the manager.
-        // If it still fails after that (e.g., invalid logical address), a violation is triggered.
-        if (!hasMemoryViolation()) { // Avoid double-triggering
-            triggerMemoryViolation(0x0);
-        }
+    if (instruction.type == InstructionType::READ || instruction.type == InstructionType::WRITE) {
+        addresses.push_back(instruction.memoryAddress);
+    }
+    for (const auto& inner : instruction.innerInstructions) {
+        collectPageAddresses(inner, addresses);
     }
 }
 
-void Screen::setTimestampFinished(std::string ts) {
+void Screen::setFinishedTime(std::time_t time) {
     // Only set the finish time if it hasn't been set yet (for memory violations)
-    if (timestampFinished.empty()) {
-        timestampFinished = ts;
+    if (finishedTime == 0) {
+        finishedTime = time;
     }
 }
\ No newline at end of file
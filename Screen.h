@@ -3,42 +3,109 @@
 #include <vector>
 #include <unordered_map>
 #include <cstdint>
+#include <ctime>
 #include <mutex>
 #include <memory>
+#include <atomic>
 #include "Instruction.h"
+#include "ProfiledMutex.h"
+#include "ProcessProfile.h"
+#include "ProcessArchive.h"
+#include "PrintLog.h"
 #include <map>
 
+// Outcome of a call to Screen::execute.
+enum class ExecutionStatus {
+    RAN,                  // Quantum used up or process finished
+    BLOCKED_ON_PAGE_FAULT // Next instruction needs pages that are not resident
+};
+
+// Tick-based scheduling metrics of a process, in Scheduler CPU cycles (-1 = not yet).
+struct ProcessMetrics {
+    int arrivalTick = -1;
+    int firstDispatchTick = -1;
+    int completionTick = -1;
+    int cpuTicks = 0;       // ticks spent on a core
+    int readyWaitTicks = 0; // ticks spent in the ready queue
+    int blockedTicks = 0;   // ticks spent parked on a page fault
+    int dispatchCount = 0;
+
+    int turnaroundTicks() const { return completionTick < 0 ? -1 : completionTick - arrivalTick; }
+    int responseTicks() const { return firstDispatchTick < 0 ? -1 : firstDispatchTick - arrivalTick; }
+};
+
+struct ProcessFaultCounters;
+struct ProcessFaultStats;
+
 class Screen {
 public:
 
     // Constructors
     Screen();
-    Screen(std::string name, std::vector<Instruction> instructions, std::string timestamp);
+    Screen(std::string name, std::vector<Instruction> instructions, std::time_t createdTime);
+    ~Screen();
 
     // Execution
-    void execute(int quantum = -1); // Executes instructions for a quantum, or until completion if -1.
+    ExecutionStatus execute(int quantum = -1); // Executes instructions for a quantum, or until completion if -1.
 
 
     // Getters
     std::string getName() const;
     int getProgramCounter() const;
     int getTotalInstructions() const; //casted from size_t to int
-    std::string getTimestamp() const;
-    std::string getTimestampFinished() const;
+    std::string getTimestamp() const;         // creation time, formatted for display
+    std::string getTimestampFinished() const; // "" until finished
+    std::time_t getCreatedTime() const;
+    std::time_t getFinishedTime() const;      // 0 until finished
     int getCoreID() const;
     bool getIsRunning() const;
     std::vector<std::string> flushOutputBuffer(); //clears and returns output
     bool isFinished() const;
     std::vector<std::string> getOutputBuffer() const;
+    long long getDroppedOutputCount() const;
+    bool isBlockedOnPageFault() const;
+    std::vector<int> getPendingPages() const;
+    const char* getStateName() const; // "ready", "running", "blocked", "finished" or "violated"
+    std::shared_ptr<ProcessFaultCounters> getFaultCounters() const; // passed to setupProcessMemory
+    ProcessFaultStats getFaultStats() const;
+
+    // Wall-clock run timings, in steady-clock nanoseconds (0 until the event has happened)
+    long long getCreatedNanos() const;
+    long long getFirstDispatchNanos() const;
+    long long getFinishedNanos() const;
+    long long getCpuNanos() const; // total time spent inside execute()
+
+    // Scheduling metrics, updated by the Scheduler worker loop as the process changes state
+    void markReady(int tick);
+    void markDispatched(int tick);
+    void markDescheduled(int tick);
+    void markBlocked(int tick);
+    void markUnblocked(int tick);
+    void markCompleted(int tick);
+    ProcessMetrics getMetrics() const;
+
+    // Instruction profile (collected while ProcessProfile::isEnabled())
+    struct ProfileSite {
+        std::string position; // instruction index, with FOR nesting: "12", "12.3", "12.3.1"
+        int depth;
+        std::string source;
+        ProcessProfile::SiteCounts counts;
+    };
+    bool hasProfile() const;
+    std::vector<ProfileSite> getProfileSites() const;
+
+    // Archival of finished processes
+    bool archive(ProcessArchive& store);
+    bool isArchived() const;
 
     // Setters
     void setName(std::string name);
-    void setTimestampFinished(std::string timestampFinished);
+    void setFinishedTime(std::time_t finishedTime);
     void setProgramCounter(int pc);
     void setInstructions(const std::vector<Instruction>& instructions);
-    void setTimestamp(const std::string& ts);
     void setCoreID(int coreID);
     void setIsRunning(bool running);
+    void setBlockedOnPageFault(bool blocked);
 
     // Memory Violation Tracking
     bool hasMemoryViolation() const;
@@ -55,13 +122,15 @@ private:
     // Helper methods
     uint16_t getOperandValue(const Operand& op);
     void setVariableValue(const std::string& name, uint16_t value);
-    void addOutput(const std::string& message);
+    void addOutput(const Instruction& print, uint16_t value);
+    std::vector<std::string> formatOutputLocked() const;
     void executeInstructionList(const std::vector<Instruction>& instructionList);
+    void executeInstruction(const Instruction& instruction);
 
     // Memory violation tracking
     bool memoryViolationOccurred;
     std::string memoryViolationAddress;
-    std::string memoryViolationTime;
+    std::time_t memoryViolationTime;
 
     // Symbol table limit (32 variables max)
     static const int MAX_VARIABLES = 32;
@@ -72,20 +141,59 @@ private:
     // Member variables
     std::string name;
     std::vector<Instruction> instructions;
-    std::string timestamp;
+    int totalInstructions; // kept after archive() frees the instructions
+    std::time_t createdTime;
 
     int programCounter; // Index of instruction
     int cpuCoreID;
-    std::string timestampFinished;
+    std::time_t finishedTime;
     bool isRunning; 
 
-    mutable std::mutex outputMutex; //protect concurrent access to the outputBUffer
-    std::vector<std::string> outputBuffer; //buffer to store log messages from PRINT
-
-    void ensureSymbolTableLoaded();
+    mutable ProfiledMutex outputMutex{ "Screen::outputMutex" }; //protect concurrent access to the outputBUffer
+    PrintLog outputBuffer; //log of the PRINTs executed, formatted on display
+    std::atomic<ProcessArchive*> archivedTo{ nullptr }; // set once the log has moved to the archive
+
+    // Asynchronous page fault state
+    void collectPageAddresses(const Instruction& instruction, std::vector<uint16_t>& addresses) const;
+    bool blockedOnPageFault;
+    bool skipResidencyCheck; // set after a page-in so the next instruction always makes progress
+    std::vector<int> pendingPages;
+
+    // Wall-clock run timings
+    std::atomic<long long> createdNanos{ 0 };
+    std::atomic<long long> firstDispatchNanos{ 0 };
+    std::atomic<long long> finishedNanos{ 0 };
+    std::atomic<long long> cpuNanos{ 0 };
+
+    // Scheduling metrics. A process is handled by one thread at a time; the atomics
+    // only make the values safe to read from the display commands.
+    std::atomic<int> arrivalTick{ -1 };
+    std::atomic<int> firstDispatchTick{ -1 };
+    std::atomic<int> completionTick{ -1 };
+    std::atomic<int> cpuTicks{ 0 };
+    std::atomic<int> readyWaitTicks{ 0 };
+    std::atomic<int> blockedTicks{ 0 };
+    std::atomic<int> dispatchCount{ 0 };
+    std::atomic<int> readySinceTick{ -1 };
+    std::atomic<int> dispatchedAtTick{ -1 };
+    std::atomic<int> blockedSinceTick{ -1 };
+
+    // Instruction profile. profile is created by the core running the process on the first
+    // quantum with profiling on; activeProfile is set only for the duration of execute().
+    void profileInstruction(const Instruction& instruction);
+    void chargeProfileSamples();
+    void collectProfileSites(const std::vector<Instruction>& list, const std::string& prefix, int depth,
+        const std::unordered_map<const Instruction*, ProcessProfile::SiteCounts>& counts, std::vector<ProfileSite>& sites) const;
+    std::atomic<ProcessProfile*> profile{ nullptr };
+    ProcessProfile* activeProfile = nullptr;
+    const Instruction* lastSampledSite = nullptr;
+    int lastSampleTick = 0;
 
     // Maps a variable name to its memory address (offset) within the symbol table.
     std::map<std::string, uint16_t> variable_offsets;
     // Keeps track of the next available memory slot in the symbol table.
     uint16_t next_variable_offset;
+
+    // Page faults charged by the MemoryManager through the process's page table.
+    std::shared_ptr<ProcessFaultCounters> faultCounters;
 };
\ No newline at end of file
@@ -2,11 +2,26 @@
 #include "CLIController.h"
 #include "MemoryManager.h"
 #include "Scheduler.h"
+#include "Clock.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <fstream>
-#include <iomanip> 
+#include <iomanip>
+#include <map>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#if defined(_WIN32) || defined(_WIN64)
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -31,23 +46,59 @@ void ScreenManager::destroy() {
 }
 
 // Registers a new screen (process) with the manager.
-void ScreenManager::registerScreen(const string& name, shared_ptr<Screen> screen) {
-    screens[name] = screen;
+void ScreenManager::registerScreen(const string& name, shared_ptr<Screen> screen, ProcessState state) {
+    registry.add(name, screen, state);
 }
 
 // Returns a pointer to a screen by its name.
 shared_ptr<Screen> ScreenManager::getScreen(const string& name) {
-    return screens.count(name) ? screens[name] : nullptr;
+    return registry.find(name);
 }
 
-// Returns a map of all registered screens.
-unordered_map<string, shared_ptr<Screen>> ScreenManager::getAllScreens() const {
-    return screens;
+// Moves a process to another state index; called by the Scheduler on every transition.
+void ScreenManager::setProcessState(const string& name, ProcessState state) {
+    registry.setState(name, state);
+}
+
+// Returns the number of processes in a state (lock-free).
+int ScreenManager::getProcessCount(ProcessState state) const {
+    return registry.count(state);
+}
+
+// Returns a consistent copy of the active processes in arrival order and, optionally,
+// the finished ones in completion order.
+ProcessRegistry::Snapshot ScreenManager::snapshotProcesses(bool includeFinished) const {
+    return registry.snapshot(includeFinished);
+}
+
+// Returns the processes in one state, in arrival (or completion) order.
+vector<shared_ptr<Screen>> ScreenManager::snapshotProcesses(ProcessState state) const {
+    return registry.snapshotState(state);
+}
+
+// Returns every registered screen, including the 'main' placeholder.
+vector<shared_ptr<Screen>> ScreenManager::getAllProcesses() const {
+    return registry.snapshotAll();
+}
+
+// Starts a new archive file for the logs of finished processes.
+bool ScreenManager::openArchive(const string& path) {
+    return archive.open(path);
+}
+
+// Compacts a finished process, moving its log to the archive file. No-op if no archive is open.
+void ScreenManager::archiveProcess(const shared_ptr<Screen>& screen) {
+    if (archive.isOpen()) screen->archive(archive);
+}
+
+const ProcessArchive& ScreenManager::getArchive() const {
+    return archive;
 }
 
 // Switches the user's current view to the specified screen.
 void ScreenManager::switchScreen(const string& name) {
-    if (screens.count(name)) currentScreen = screens[name];
+    shared_ptr<Screen> screen = registry.find(name);
+    if (screen) currentScreen = screen;
 }
 
 // Returns a pointer to the currently active screen.
@@ -57,7 +108,7 @@ shared_ptr<Screen> ScreenManager::getCurrentScreen() {
 
 // Checks if a screen with the given name exists.
 bool ScreenManager::hasScreen(const string& name) const {
-    return screens.find(name) != screens.end();
+    return registry.contains(name);
 }
 
 void ScreenManager::displayProcessSMI() {
@@ -72,12 +123,19 @@ void ScreenManager::displayProcessSMI() {
 
     cout << "Process name: " << screen.getName() << endl;
     cout << "Logs:" << endl;
+    long long dropped = screen.getDroppedOutputCount();
+    if (dropped > 0) {
+        cout << "(" << dropped << " older lines overwritten; print-log-capacity is " << PrintLog::getDefaultCapacity() << ")" << endl;
+    }
 
     // Use the getter to access logs safely
     for (const auto& line : screen.getOutputBuffer()) {
         cout << line << endl;
     }
 
+    ProcessFaultStats faults = screen.getFaultStats();
+    cout << endl << "Page faults: " << faults.minorFaults << " minor / " << faults.majorFaults << " major" << endl;
+
     cout << endl;
     if (isFinished) {
         cout << endl << "Finished!" << endl;
@@ -110,30 +168,40 @@ void ScreenManager::displaySystemSmiSummary() {
     int availableCores = scheduler->getAvailableCores();
 
     
+    ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
     cout << "PROCESS-SMI V1.00 Driver Version: 0.001" << endl;
     cout << "========================================================" << endl;
-    cout << "CPU Utilization: " << usedCores << " / " << availableCores << " Cores" << endl;
+    CoreStats cores = scheduler->getAggregateCoreStats();
+    cout << "CPU Utilization: " << usedCores << " / " << availableCores << " Cores"
+        << " (" << fixed << setprecision(1) << cores.utilization() << "% over the run)" << endl;
+    for (int i = 0; i < scheduler->getNumCores(); ++i) {
+        CoreStats core = scheduler->getCoreStats(i);
+        cout << "  Core " << i << ": " << (core.busy ? "busy" : "idle") << "  "
+            << fixed << setprecision(1) << core.utilization() << "%" << endl;
+    }
     cout << "Memory Usage: " << usedMem << "B / " << totalMem << "B" << endl;
     cout << "Memory Util: " << fixed << setprecision(2) << memUtilization << "%" << endl;
     cout << "--------------------------------------------------------" << endl;
     cout << "Running processes and memory usage:" << endl;
 
-    auto allScreens = getAllScreens();
     int runningProcessCount = 0;
-    for (const auto& pair : allScreens) {
-        if (pair.first != "main" && !pair.second->isFinished()) {
-            runningProcessCount++;
-            
-            int processMem = memManager->getProcessMemoryUsage(pair.first);
-            cout << "  - Process: " << left << setw(15) << pair.first
-                << "Memory: " << processMem << " bytes" << endl;
-        }
+    for (const auto& screen : snapshotProcesses(false).active) {
+        runningProcessCount++;
+
+        int processMem = memManager->getProcessMemoryUsage(screen->getName());
+        ProcessFaultStats faults = screen->getFaultStats();
+        cout << "  - Process: " << left << setw(15) << screen->getName()
+            << "Memory: " << setw(12) << (to_string(processMem) + " bytes")
+            << "Faults: " << faults.minorFaults << " minor / " << faults.majorFaults << " major" << endl;
     }
 
     if (runningProcessCount == 0) {
         cout << "  No running processes." << endl;
     }
     cout << "========================================================" << endl;
+    cout.flags(flags);
+    cout.precision(precision);
 }
 
 // Displays detailed virtual memory statistics (for the 'vmstat' command).
@@ -155,10 +223,11 @@ void ScreenManager::displayVmStat() {
 
     
     int totalTicks = scheduler->getCpuCycles();
-    int idleTicks = scheduler->getIdleCpuTicks(); 
-    int activeTicks = totalTicks - idleTicks;
+    CoreStats cores = scheduler->getAggregateCoreStats();
 
     // Display formatted output
+    ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
     cout << "--------------------- VM STATS ---------------------" << endl;
     cout << " Memory" << endl;
     cout << left << setw(25) << " Total:" << totalMem << " B" << endl;
@@ -167,11 +236,375 @@ void ScreenManager::displayVmStat() {
     cout << "----------------------------------------------------" << endl;
     cout << " Cpu Ticks" << endl;
     cout << left << setw(25) << " Total:" << totalTicks << endl;
-    cout << left << setw(25) << " Active:" << activeTicks << endl;
-    cout << left << setw(25) << " Idle:" << idleTicks << endl;
+    cout << left << setw(25) << " Active core ticks:" << cores.busyTicks << endl;
+    cout << left << setw(25) << " Idle core ticks:" << cores.idleTicks << endl;
+    cout << left << setw(25) << " Utilization:" << fixed << setprecision(1) << cores.utilization() << "%" << endl;
+    for (int i = 0; i < scheduler->getNumCores(); ++i) {
+        CoreStats core = scheduler->getCoreStats(i);
+        cout << left << setw(25) << (" Core " + to_string(i) + ":") << setw(6) << (core.busy ? "busy" : "idle")
+            << fixed << setprecision(1) << core.utilization() << "% (" << core.busyTicks << " / "
+            << core.busyTicks + core.idleTicks << " ticks)" << endl;
+    }
     cout << "----------------------------------------------------" << endl;
     cout << " Paging" << endl;
     cout << left << setw(25) << " Paged in:" << pagedIn << endl;
     cout << left << setw(25) << " Paged out:" << pagedOut << endl;
+    cout << left << setw(25) << " Pinned frames:" << memManager->getPinnedFrameCount() << endl;
+    cout << "----------------------------------------------------" << endl;
+    cout << " Fault Service" << endl;
+    cout << left << setw(25) << " Minor faults:" << memManager->getMinorFaultCount() << endl;
+    cout << left << setw(25) << " Major faults:" << memManager->getMajorFaultCount() << endl;
+    cout << left << setw(25) << " Fault latency:" << memManager->getFaultServiceLatency().summary() << endl;
+    cout << left << setw(25) << " Writeback latency:" << memManager->getWritebackLatency().summary() << endl;
+    cout << left << setw(25) << " Store read latency:" << memManager->getBackingStoreReadLatency().summary() << endl;
+    cout << left << setw(25) << " Async page-ins:" << memManager->getAsyncPageInCount() << endl;
+    cout << left << setw(25) << " Blocked processes:" << scheduler->getBlockedProcessCount() << endl;
+    cout << left << setw(25) << " Archived processes:" << archive.getArchivedCount()
+        << " (" << archive.getBytesWritten() << " B of logs on disk)" << endl;
+    cout << left << setw(25) << " Compressed tier:" << memManager->getCompressedFaultCount()
+        << " faults, avg " << fixed << setprecision(2) << memManager->getCompressedFaultAvgMicros() << " us" << endl;
+    cout << left << setw(25) << " Backing store:" << memManager->getDiskFaultCount()
+        << " faults, avg " << fixed << setprecision(2) << memManager->getDiskFaultAvgMicros() << " us" << endl;
+    const CompressedSwapPool* pool = memManager->getCompressedSwapPool();
+    if (pool) {
+        cout << left << setw(25) << " Pool used:" << pool->getUsedBytes() << " B / " << pool->getMaxBytes() << " B" << endl;
+        cout << left << setw(25) << " Pool pages:" << pool->getStoredPageCount() << endl;
+        cout << left << setw(25) << " Spilled to disk:" << pool->getSpilledCount() << endl;
+        cout << left << setw(25) << " Rejected:" << pool->getRejectedCount() << endl;
+    }
     cout << "----------------------------------------------------" << endl;
-}
\ No newline at end of file
+    cout << " Page Merging" << (memManager->isPageMergingEnabled() ? "" : " (disabled)") << endl;
+    cout << left << setw(25) << " Pages merged:" << memManager->getPagesMergedCount() << endl;
+    cout << left << setw(25) << " Pages unmerged:" << memManager->getPagesUnmergedCount() << endl;
+    cout << left << setw(25) << " Zero-page maps:" << memManager->getZeroPageMapCount() << endl;
+    cout << left << setw(25) << " Frames saved:" << memManager->getFramesSaved() << endl;
+    cout << "----------------------------------------------------" << endl;
+    cout.flags(flags);
+    cout.precision(precision);
+}
+
+// Column headings and one row of the vmstat history, in the style of Unix vmstat:
+// r/b are ready and blocked processes, cpu the busy cores, and pi/po/flt/instr the
+// page-ins, page-outs, faults and instructions between the two samples.
+static void writeVmStatHeader(ostream& out) {
+    out << right << setw(8) << "tick" << setw(5) << "r" << setw(5) << "b" << setw(5) << "cpu" << setw(8) << "frames"
+        << setw(7) << "pi" << setw(7) << "po" << setw(7) << "flt" << setw(10) << "instr"
+        << setw(11) << "instr/s" << setw(9) << "flt/s" << "\n";
+}
+
+static void writeVmStatRow(ostream& out, const VmStatSample& from, const VmStatSample& to) {
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    double seconds = max(1e-9, (to.nanos - from.nanos) / 1e9);
+    out << right << setw(8) << to.tick << setw(5) << to.readyProcesses << setw(5) << to.blockedProcesses
+        << setw(5) << to.busyCores << setw(8) << to.usedFrames
+        << setw(7) << to.pagedIn - from.pagedIn << setw(7) << to.pagedOut - from.pagedOut
+        << setw(7) << to.faults - from.faults << setw(10) << to.instructions - from.instructions
+        << fixed << setprecision(1) << setw(11) << (to.instructions - from.instructions) / seconds
+        << setw(9) << (to.faults - from.faults) / seconds << "\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// Displays the last ticks of the vmstat history one row per tick, followed by the rates over
+// the whole history and over its two halves, so a drop in throughput stands out
+// (for the 'vmstat -h [ticks]' command).
+void ScreenManager::displayVmStatHistory(int ticks) {
+    Scheduler* scheduler = Scheduler::getInstance();
+    if (!scheduler) {
+        cout << "System is not fully initialized. Please use the 'initialize' command." << endl;
+        return;
+    }
+    const VmStatHistory& history = scheduler->getVmStatHistory();
+    vector<VmStatSample> samples = history.snapshot();
+    if (samples.size() < 2) {
+        cout << "Not enough vmstat history yet; samples are recorded once per CPU tick." << endl;
+        return;
+    }
+
+    size_t first = samples.size() > static_cast<size_t>(ticks) + 1 ? samples.size() - ticks - 1 : 0;
+    writeVmStatHeader(cout);
+    for (size_t i = first + 1; i < samples.size(); ++i) writeVmStatRow(cout, samples[i - 1], samples[i]);
+
+    auto instructionRate = [](const VmStatSample& from, const VmStatSample& to) {
+        return (to.instructions - from.instructions) / max(1e-9, (to.nanos - from.nanos) / 1e9);
+    };
+    const VmStatSample& oldest = samples.front();
+    const VmStatSample& middle = samples[samples.size() / 2];
+    const VmStatSample& newest = samples.back();
+    double seconds = max(1e-9, (newest.nanos - oldest.nanos) / 1e9);
+    ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+    cout << fixed << setprecision(1);
+    cout << "\nHistory: ticks " << oldest.tick << "-" << newest.tick << " (" << samples.size() << " of "
+        << history.getCapacity() << " samples), " << instructionRate(oldest, newest) << " instr/s, "
+        << (newest.faults - oldest.faults) / seconds << " faults/s\n";
+    cout << "Trend:   " << instructionRate(oldest, middle) << " instr/s in the first half, "
+        << instructionRate(middle, newest) << " instr/s in the second half\n";
+    cout.flags(flags);
+    cout.precision(precision);
+}
+
+// Prints count rows, each covering the next intervalTicks CPU ticks, as they complete
+// (for the 'vmstat <interval> [count]' command).
+void ScreenManager::displayVmStatSeries(int intervalTicks, int count) {
+    Scheduler* scheduler = Scheduler::getInstance();
+    if (!scheduler) {
+        cout << "System is not fully initialized. Please use the 'initialize' command." << endl;
+        return;
+    }
+    const VmStatHistory& history = scheduler->getVmStatHistory();
+    VmStatSample start;
+    if (!history.latest(start)) {
+        cout << "Not enough vmstat history yet; samples are recorded once per CPU tick." << endl;
+        return;
+    }
+
+    writeVmStatHeader(cout);
+    cout << flush;
+    for (int row = 0; row < count; ++row) {
+        VmStatSample end = start;
+        while (end.tick < start.tick + intervalTicks && scheduler->getSchedulerRunning()) {
+            this_thread::sleep_for(chrono::milliseconds(20));
+            history.latest(end);
+        }
+        if (end.tick == start.tick) break; // the scheduler stopped
+        writeVmStatRow(cout, start, end);
+        cout << flush;
+        start = end;
+    }
+}
+
+static const int TOP_NAME_WIDTH = 14;
+static const size_t TOP_BUSIEST_COUNT = 5;
+
+// Counters sampled for one frame of the 'top' dashboard. All of them are atomics or
+// per-core slots, so sampling never takes the scheduler, memory or registry locks.
+struct TopSample {
+    long long nanos = 0;
+    int tick = 0;
+    long long instructions = 0;
+    int minorFaults = 0;
+    int majorFaults = 0;
+    vector<CoreStats> cores;
+};
+
+static TopSample sampleTop(Scheduler* scheduler, MemoryManager* memManager) {
+    TopSample sample;
+    sample.nanos = Clock::monotonicNanos();
+    sample.tick = scheduler->getCpuCycles();
+    sample.instructions = scheduler->getInstructionsExecuted();
+    sample.minorFaults = memManager->getMinorFaultCount();
+    sample.majorFaults = memManager->getMajorFaultCount();
+    sample.cores.reserve(scheduler->getNumCores());
+    for (int i = 0; i < scheduler->getNumCores(); ++i) sample.cores.push_back(scheduler->getCoreStats(i));
+    return sample;
+}
+
+// Formats one frame from two consecutive samples; rates are per second of wall time.
+static string formatTopFrame(const TopSample& previous, const TopSample& current, const ScreenManager& screens,
+    Scheduler* scheduler, MemoryManager* memManager, bool interactive) {
+    double seconds = max(1e-9, (current.nanos - previous.nanos) / 1e9);
+    auto rate = [seconds](long long delta) { return delta / seconds; };
+    int busyCores = 0;
+    for (const CoreStats& core : current.cores) if (!core.process.empty()) busyCores++;
+    long long busyTicks = 0, idleTicks = 0;
+    for (size_t i = 0; i < current.cores.size(); ++i) {
+        busyTicks += current.cores[i].busyTicks - previous.cores[i].busyTicks;
+        idleTicks += current.cores[i].idleTicks - previous.cores[i].idleTicks;
+    }
+    int totalMem = memManager->getTotalMemory();
+    int usedMem = memManager->getUsedMemory();
+
+    stringstream ss;
+    ss << fixed << setprecision(1);
+    ss << CLIController::COLOR_BLUE << "top - " << Clock::now() << "   tick " << current.tick << "   "
+        << scheduler->getAlgorithm() << CLIController::COLOR_RESET
+        << (interactive ? "   (press Enter to return)" : "") << "\n";
+    ss << "Cores:     " << busyCores << " / " << current.cores.size() << " busy, "
+        << (busyTicks + idleTicks > 0 ? 100.0 * busyTicks / (busyTicks + idleTicks) : 0.0) << "% utilized\n";
+    ss << "Processes: " << screens.getProcessCount(ProcessState::READY) << " ready, "
+        << screens.getProcessCount(ProcessState::RUNNING) << " running, "
+        << screens.getProcessCount(ProcessState::BLOCKED) << " blocked, "
+        << screens.getProcessCount(ProcessState::FINISHED) << " finished, "
+        << screens.getProcessCount(ProcessState::VIOLATED) << " violated\n";
+    ss << "Rates:     " << rate(current.instructions - previous.instructions) << " instr/s, "
+        << rate(current.tick - previous.tick) << " ticks/s, "
+        << rate(current.minorFaults - previous.minorFaults) << " minor + "
+        << rate(current.majorFaults - previous.majorFaults) << " major faults/s\n";
+    ss << "Memory:    " << usedMem << " / " << totalMem << " B used ("
+        << (totalMem > 0 ? 100.0 * usedMem / totalMem : 0.0) << "%)\n";
+    ss << "\n";
+    ss << left << setw(6) << "Core" << setw(7) << "State" << right << setw(8) << "Util" << setw(12) << "Instr/s"
+        << "  " << left << setw(TOP_NAME_WIDTH) << "Process" << right << setw(10) << "CPU ticks" << "\n";
+    for (size_t i = 0; i < current.cores.size(); ++i) {
+        const CoreStats& core = current.cores[i];
+        ss << left << setw(6) << i << setw(7) << (core.process.empty() ? "idle" : "busy") << right
+            << setw(7) << core.utilization() << "%" << setw(12) << rate(core.instructions - previous.cores[i].instructions)
+            << "  " << left << setw(TOP_NAME_WIDTH) << (core.process.empty() ? "-" : core.process) << right;
+        if (!core.process.empty()) ss << setw(10) << core.processCpuTicks;
+        ss << "\n";
+    }
+
+    // Busiest processes: those holding a core, by CPU time consumed so far.
+    vector<const CoreStats*> onCore;
+    for (const CoreStats& core : current.cores) if (!core.process.empty()) onCore.push_back(&core);
+    sort(onCore.begin(), onCore.end(), [](const CoreStats* a, const CoreStats* b) { return a->processCpuTicks > b->processCpuTicks; });
+    ss << "\nBusiest processes (on a core, by CPU ticks):\n";
+    if (onCore.empty()) ss << " (None)\n";
+    for (size_t i = 0; i < onCore.size() && i < TOP_BUSIEST_COUNT; ++i) {
+        ss << " " << left << setw(TOP_NAME_WIDTH) << onCore[i]->process << right << setw(10) << onCore[i]->processCpuTicks << "\n";
+    }
+    return ss.str();
+}
+
+// Runs the live dashboard (for the 'top' command). It redraws in place every
+// top-refresh-ms until Enter is pressed, or for the given number of frames.
+void ScreenManager::displayTop(int frames) {
+    MemoryManager* memManager = MemoryManager::getInstance();
+    Scheduler* scheduler = Scheduler::getInstance();
+    if (!memManager || !scheduler) {
+        cout << "System is not fully initialized. Please use the 'initialize' command." << endl;
+        return;
+    }
+
+    // Without a frame count, a helper thread waits for Enter while this one draws.
+    // Only a terminal can send that Enter; piped input would be consumed as a keypress.
+    bool interactive = frames <= 0;
+    if (interactive && !isatty(fileno(stdin))) {
+        cout << "top needs a terminal to wait for Enter. Use top -n <frames>." << endl;
+        return;
+    }
+    atomic<bool> quit{ false };
+    thread keyReader;
+    if (interactive) {
+        keyReader = thread([&quit]() {
+            string line;
+            getline(cin, line);
+            quit.store(true);
+        });
+    }
+
+    CLIController* cli = CLIController::getInstance();
+    const auto refresh = chrono::milliseconds(scheduler->getTopRefreshMs());
+    const auto pollStep = chrono::milliseconds(20);
+    cli->beginLiveView();
+    TopSample previous = sampleTop(scheduler, memManager);
+    for (int frame = 0; !quit.load() && (interactive || frame < frames); ++frame) {
+        for (auto waited = chrono::milliseconds(0); waited < refresh && !quit.load(); waited += pollStep) {
+            this_thread::sleep_for(min(pollStep, refresh - waited));
+        }
+        if (quit.load()) break;
+        TopSample current = sampleTop(scheduler, memManager);
+        cli->redrawLiveView(formatTopFrame(previous, current, *this, scheduler, memManager, interactive));
+        previous = move(current);
+    }
+    cli->endLiveView();
+    if (keyReader.joinable()) keyReader.join();
+}
+
+// Displays the hottest instructions of one process (for the 'process-prof <name>' command).
+void ScreenManager::displayProcessProfile(const string& name) {
+    shared_ptr<Screen> screen = hasScreen(name) ? getScreen(name) : nullptr;
+    if (!screen) {
+        cout << "Process '" << name << "' not found." << endl;
+        return;
+    }
+    if (!screen->hasProfile()) {
+        cout << "No profile for '" << name << "'. Use 'process-prof on' before it runs." << endl;
+        return;
+    }
+
+    vector<Screen::ProfileSite> sites = screen->getProfileSites();
+    long long totalSamples = 0, totalExecutions = 0, totalFaults = 0;
+    for (const auto& site : sites) {
+        totalSamples += site.counts.samples;
+        totalExecutions += site.counts.executions;
+        totalFaults += site.counts.faults;
+    }
+
+    // Hottest first: by sampled ticks, then by exact execution count.
+    vector<const Screen::ProfileSite*> hot;
+    for (const auto& site : sites) {
+        if (site.counts.executions > 0 || site.counts.samples > 0) hot.push_back(&site);
+    }
+    sort(hot.begin(), hot.end(), [](const auto* a, const auto* b) {
+        if (a->counts.samples != b->counts.samples) return a->counts.samples > b->counts.samples;
+        return a->counts.executions > b->counts.executions;
+    });
+
+    ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+    cout << "Profile of " << name << ": " << totalExecutions << " instructions executed, "
+        << totalSamples << " ticks sampled, " << totalFaults << " page faults" << endl;
+    cout << left << setw(12) << "Position" << setw(36) << "Instruction" << right << setw(10) << "Execs"
+        << setw(8) << "Faults" << setw(8) << "Ticks" << setw(8) << "Ticks%" << endl;
+    const size_t maxRows = 20;
+    for (size_t i = 0; i < hot.size() && i < maxRows; ++i) {
+        const auto& site = *hot[i];
+        string source = string(site.depth * 2, ' ') + site.source;
+        if (source.size() > 34) source = source.substr(0, 31) + "...";
+        double share = totalSamples > 0 ? 100.0 * site.counts.samples / totalSamples : 0.0;
+        cout << left << setw(12) << site.position << setw(36) << source << right << setw(10) << site.counts.executions
+            << setw(8) << site.counts.faults << setw(8) << site.counts.samples
+            << setw(7) << fixed << setprecision(1) << share << "%" << endl;
+    }
+    if (hot.size() > maxRows) cout << "(" << hot.size() - maxRows << " more instructions)" << endl;
+    cout.flags(flags);
+    cout.precision(precision);
+}
+
+// Displays the profile aggregated over all generated processes, by instruction type and FOR depth
+// (for the 'process-prof' command).
+void ScreenManager::displayGeneratedProfile() {
+    struct TypeTotals {
+        long long executions = 0;
+        long long faults = 0;
+        long long samples = 0;
+    };
+    map<pair<string, int>, TypeTotals> totals;
+    int profiledProcesses = 0;
+    long long totalSamples = 0;
+
+    for (const auto& screen : getAllProcesses()) {
+        const string& name = screen->getName();
+        // Generated processes are named "p<N>" by the Scheduler.
+        bool generated = name.size() > 1 && name[0] == 'p' &&
+            all_of(name.begin() + 1, name.end(), [](char c) { return isdigit(static_cast<unsigned char>(c)); });
+        if (!generated || !screen->hasProfile()) continue;
+        profiledProcesses++;
+        for (const auto& site : screen->getProfileSites()) {
+            string type = site.source.substr(0, site.source.find(' '));
+            TypeTotals& entry = totals[{ type, site.depth }];
+            entry.executions += site.counts.executions;
+            entry.faults += site.counts.faults;
+            entry.samples += site.counts.samples;
+            totalSamples += site.counts.samples;
+        }
+    }
+
+    if (profiledProcesses == 0) {
+        cout << "No generated process has a profile. Use 'process-prof on' to start profiling." << endl;
+        return;
+    }
+
+    vector<pair<pair<string, int>, TypeTotals>> rows(totals.begin(), totals.end());
+    sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        if (a.second.samples != b.second.samples) return a.second.samples > b.second.samples;
+        return a.second.executions > b.second.executions;
+    });
+
+    ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+    cout << "Profile of " << profiledProcesses << " generated processes by instruction type and FOR depth:" << endl;
+    cout << left << setw(12) << "Type" << right << setw(6) << "Depth" << setw(12) << "Execs"
+        << setw(10) << "Faults" << setw(10) << "Ticks" << setw(8) << "Ticks%" << endl;
+    for (const auto& [key, entry] : rows) {
+        double share = totalSamples > 0 ? 100.0 * entry.samples / totalSamples : 0.0;
+        cout << left << setw(12) << key.first << right << setw(6) << key.second << setw(12) << entry.executions
+            << setw(10) << entry.faults << setw(10) << entry.samples
+            << setw(7) << fixed << setprecision(1) << share << "%" << endl;
+    }
+    cout.flags(flags);
+    cout.precision(precision);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Screen.h"
+#include "ProcessRegistry.h"
 #include <memory>
 #include <unordered_map>
 #include <string>
@@ -15,25 +16,41 @@ public:
 	static void destroy();
 
 	// Screen Management
-	void registerScreen(const string& name, shared_ptr<Screen> screen);
+	void registerScreen(const string& name, shared_ptr<Screen> screen, ProcessState state = ProcessState::NEW);
 	void switchScreen(const string& name);
 	shared_ptr<Screen> getCurrentScreen();
 	bool hasScreen(const string& name) const;
 	shared_ptr<Screen> getScreen(const string& name);
 
+	// Process State Index
+	void setProcessState(const string& name, ProcessState state);
+	int getProcessCount(ProcessState state) const;
+	ProcessRegistry::Snapshot snapshotProcesses(bool includeFinished = true) const;
+	vector<shared_ptr<Screen>> snapshotProcesses(ProcessState state) const;
+	vector<shared_ptr<Screen>> getAllProcesses() const;
+
+	// Archival of Finished Processes
+	bool openArchive(const string& path);
+	void archiveProcess(const shared_ptr<Screen>& screen);
+	const ProcessArchive& getArchive() const;
+
 	// Display Commands
 	void displayProcessSMI();
 	void displaySystemSmiSummary();
 	void displayVmStat();
-
-	std::unordered_map<std::string, shared_ptr<Screen>> getAllScreens() const;
+	void displayVmStatHistory(int ticks);
+	void displayVmStatSeries(int intervalTicks, int count);
+	void displayTop(int frames = 0); // 0 = refresh until Enter is pressed
+	void displayProcessProfile(const string& name);
+	void displayGeneratedProfile();
 
 private:
 	ScreenManager();
 	static ScreenManager* instance;
 
 	// Data Structures
-	unordered_map<string, shared_ptr<Screen>> screens;
+	ProcessRegistry registry;
+	ProcessArchive archive;
 	unordered_map<string, vector<std::string>> processLogs;
 	shared_ptr<Screen> currentScreen;
 };
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "VmStatHistory.h"
+#include <algorithm>
+using namespace std;
+
+void VmStatHistory::setCapacity(size_t value) {
+    lock_guard<mutex> lock(samplesMutex);
+    capacity = max<size_t>(2, value);
+    vector<VmStatSample>().swap(samples);
+    head = 0;
+}
+
+size_t VmStatHistory::getCapacity() const {
+    lock_guard<mutex> lock(samplesMutex);
+    return capacity;
+}
+
+// Stores a sample, overwriting the oldest one when the ring is full.
+void VmStatHistory::record(const VmStatSample& sample) {
+    lock_guard<mutex> lock(samplesMutex);
+    if (samples.size() < capacity) {
+        samples.push_back(sample);
+        return;
+    }
+    samples[head] = sample;
+    head = (head + 1) % capacity;
+}
+
+// Copies the newest sample. Returns false if nothing has been recorded yet.
+bool VmStatHistory::latest(VmStatSample& sample) const {
+    lock_guard<mutex> lock(samplesMutex);
+    if (samples.empty()) return false;
+    sample = samples[(head + samples.size() - 1) % samples.size()];
+    return true;
+}
+
+// Returns the newest 'last' samples (all of them if 0), oldest first.
+vector<VmStatSample> VmStatHistory::snapshot(size_t last) const {
+    lock_guard<mutex> lock(samplesMutex);
+    size_t count = (last == 0 || last > samples.size()) ? samples.size() : last;
+    vector<VmStatSample> ordered;
+    ordered.reserve(count);
+    for (size_t i = samples.size() - count; i < samples.size(); ++i) {
+        ordered.push_back(samples[(head + i) % samples.size()]);
+    }
+    return ordered;
+}
+
+size_t VmStatHistory::size() const {
+    lock_guard<mutex> lock(samplesMutex);
+    return samples.size();
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Cumulative system counters sampled at the end of one CPU tick.
+struct VmStatSample {
+    int tick = 0;
+    long long nanos = 0;         // monotonic time of the sample
+    long long instructions = 0;  // executed by all cores
+    int pagedIn = 0;
+    int pagedOut = 0;
+    int faults = 0;              // minor + major
+    int usedFrames = 0;
+    int readyProcesses = 0;      // ready queue depth
+    int blockedProcesses = 0;
+    int busyCores = 0;
+};
+
+// Fixed-size ring of per-tick samples behind 'vmstat -h' and 'vmstat <interval> <count>'.
+// The tick thread records one sample per tick from atomic counters only; readers copy
+// the samples they need and compute deltas and rates between them.
+class VmStatHistory {
+public:
+    static const size_t DEFAULT_CAPACITY = 1024;
+
+    // Configuration (vmstat-history-ticks); clears the history.
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+
+    // Recording
+    void record(const VmStatSample& sample);
+
+    // Reading
+    bool latest(VmStatSample& sample) const;
+    std::vector<VmStatSample> snapshot(size_t last = 0) const; // oldest first; 0 = every sample
+    size_t size() const;
+
+private:
+    mutable std::mutex samplesMutex;
+    std::vector<VmStatSample> samples;
+    size_t capacity = DEFAULT_CAPACITY;
+    size_t head = 0; // oldest sample once the ring is full
+};
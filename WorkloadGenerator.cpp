@@ -0,0 +1,124 @@
+#include "WorkloadGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+using namespace std;
+
+// Maps a config value to an address pattern. Returns false for unknown names.
+bool WorkloadConfig::parsePattern(const string& name, AddressPattern& pattern) {
+    if (name == "uniform") pattern = AddressPattern::UNIFORM;
+    else if (name == "sequential") pattern = AddressPattern::SEQUENTIAL;
+    else if (name == "strided") pattern = AddressPattern::STRIDED;
+    else if (name == "zipf") pattern = AddressPattern::ZIPF;
+    else if (name == "phased") pattern = AddressPattern::PHASED;
+    else if (name == "loop") pattern = AddressPattern::LOOP;
+    else return false;
+    return true;
+}
+
+// Returns the config name of an address pattern.
+string WorkloadConfig::patternName(AddressPattern pattern) {
+    switch (pattern) {
+    case AddressPattern::SEQUENTIAL: return "sequential";
+    case AddressPattern::STRIDED: return "strided";
+    case AddressPattern::ZIPF: return "zipf";
+    case AddressPattern::PHASED: return "phased";
+    case AddressPattern::LOOP: return "loop";
+    case AddressPattern::UNIFORM:
+    default: return "uniform";
+    }
+}
+
+// Parses seven space-separated weights. Leaves the mix unchanged and returns false if invalid.
+bool WorkloadConfig::parseInstructionMix(const string& value) {
+    stringstream ss(value);
+    vector<double> weights;
+    double weight;
+    while (ss >> weight) {
+        if (weight < 0) return false;
+        weights.push_back(weight);
+    }
+    if (weights.size() != 7 || accumulate(weights.begin(), weights.end(), 0.0) <= 0) return false;
+    instructionMix = weights;
+    return true;
+}
+
+// Constructor: prepares the per-process state the configured pattern needs.
+AddressStream::AddressStream(const WorkloadConfig& config, int processMemorySize, int frameSize, mt19937& gen)
+    : config(config), gen(gen), memorySize(max(processMemorySize, 1)), frameSize(max(frameSize, 1)) {
+    numPages = max(1, (memorySize + this->frameSize - 1) / this->frameSize);
+
+    if (config.pattern == AddressPattern::ZIPF) {
+        // Shuffle which pages are hot so processes do not all favor page 0.
+        pageByRank.resize(numPages);
+        iota(pageByRank.begin(), pageByRank.end(), 0);
+        shuffle(pageByRank.begin(), pageByRank.end(), gen);
+
+        double total = 0;
+        zipfCdf.resize(numPages);
+        for (int rank = 0; rank < numPages; ++rank) {
+            total += 1.0 / pow(rank + 1, config.zipfExponent);
+            zipfCdf[rank] = total;
+        }
+        for (auto& p : zipfCdf) p /= total;
+    }
+    else if (config.pattern == AddressPattern::PHASED) {
+        startPhase();
+    }
+    else if (config.pattern == AddressPattern::LOOP) {
+        int arrayBytes = min(memorySize, config.workingSetPages * this->frameSize);
+        loopBase = uniform_int_distribution<>(0, max(0, memorySize - arrayBytes) / 2)(gen) * 2;
+    }
+}
+
+// Returns the next address, always inside [0, processMemorySize).
+uint16_t AddressStream::next() {
+    switch (config.pattern) {
+    case AddressPattern::SEQUENTIAL: {
+        int address = cursor;
+        cursor = (cursor + 2) % memorySize;
+        return static_cast<uint16_t>(address);
+    }
+    case AddressPattern::STRIDED: {
+        int address = cursor;
+        int stride = config.stride > 0 ? config.stride : frameSize;
+        cursor = (cursor + stride) % memorySize;
+        return static_cast<uint16_t>(address);
+    }
+    case AddressPattern::ZIPF: {
+        double u = uniform_real_distribution<>(0.0, 1.0)(gen);
+        int rank = static_cast<int>(lower_bound(zipfCdf.begin(), zipfCdf.end(), u) - zipfCdf.begin());
+        return addressInPage(pageByRank[min(rank, numPages - 1)]);
+    }
+    case AddressPattern::PHASED: {
+        if (accessesInPhase++ >= config.phaseLength) startPhase();
+        int pages = min(config.workingSetPages, numPages);
+        return addressInPage(phaseBasePage + uniform_int_distribution<>(0, pages - 1)(gen));
+    }
+    case AddressPattern::LOOP: {
+        int arrayBytes = min(memorySize - loopBase, config.workingSetPages * frameSize);
+        int address = loopBase + cursor;
+        cursor = (cursor + 2) % max(arrayBytes, 2);
+        return static_cast<uint16_t>(min(address, memorySize - 1));
+    }
+    case AddressPattern::UNIFORM:
+    default:
+        return static_cast<uint16_t>(uniform_int_distribution<>(0, memorySize - 1)(gen));
+    }
+}
+
+// Returns a random word-aligned address inside the given page, clipped to the process's memory.
+uint16_t AddressStream::addressInPage(int page) {
+    int pageStart = page * frameSize;
+    int pageBytes = min(frameSize, memorySize - pageStart);
+    int offset = uniform_int_distribution<>(0, max(0, pageBytes - 1) / 2)(gen) * 2;
+    return static_cast<uint16_t>(pageStart + offset);
+}
+
+// Moves the PHASED working set to a new random position.
+void AddressStream::startPhase() {
+    int pages = min(config.workingSetPages, numPages);
+    phaseBasePage = uniform_int_distribution<>(0, numPages - pages)(gen);
+    accessesInPhase = 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+// Address patterns available for generated READ/WRITE instructions.
+enum class AddressPattern {
+    UNIFORM,    // every address equally likely (original behavior)
+    SEQUENTIAL, // word-by-word scan that wraps around
+    STRIDED,    // fixed stride scan that wraps around
+    ZIPF,       // a few hot pages take most accesses
+    PHASED,     // a small working set that moves every phase
+    LOOP        // repeated sweeps over a small array, as in a loop nest
+};
+
+// Workload settings read from config.txt.
+struct WorkloadConfig {
+    AddressPattern pattern = AddressPattern::UNIFORM;
+    int stride = 0;             // bytes; 0 means one frame
+    double zipfExponent = 1.0;
+    int workingSetPages = 2;    // pages in a PHASED working set or LOOP array
+    int phaseLength = 50;       // accesses before a PHASED working set moves
+
+    // Relative weights for PRINT, DECLARE, ADD, SUBTRACT, SLEEP, READ, WRITE.
+    // The default matches the original generator, where DECLARE and FOR draws fell back to PRINT.
+    std::vector<double> instructionMix = { 3, 0, 1, 1, 1, 0, 0 };
+
+    static bool parsePattern(const std::string& name, AddressPattern& pattern);
+    static std::string patternName(AddressPattern pattern);
+    bool parseInstructionMix(const std::string& value);
+};
+
+// Produces the addresses of one process's READ/WRITE instructions according to a pattern.
+class AddressStream {
+public:
+    AddressStream(const WorkloadConfig& config, int processMemorySize, int frameSize, std::mt19937& gen);
+
+    uint16_t next();
+
+private:
+    uint16_t addressInPage(int page);
+    void startPhase();
+
+    const WorkloadConfig& config;
+    std::mt19937& gen;
+    int memorySize;
+    int frameSize;
+    int numPages;
+
+    int cursor = 0;                 // SEQUENTIAL / STRIDED / LOOP position in bytes
+    int accessesInPhase = 0;
+    int phaseBasePage = 0;
+    int loopBase = 0;
+    std::vector<int> pageByRank;    // ZIPF: page for each popularity rank
+    std::vector<double> zipfCdf;    // ZIPF: cumulative probability by rank
+};
@@ -1,4 +1,5 @@
 #include "CLIController.h"
+#include "Clock.h"
 #include "Kernel.h"
 #include "CommandInputController.h"
 #include "ScreenManager.h"
@@ -8,41 +9,78 @@
 #include "MemoryManager.h"
 #include <memory>
 #include <iostream>
+#include <fstream>
+#include <string>
 #include <vector> 
 #include <thread>
+#include <cstdio>
+#if defined(_WIN32) || defined(_WIN64)
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
 
 using namespace std;
 
-int main() {
+// Usage: CSOPESY [--script <file>]
+// With --script, or when stdin is not a terminal, commands are read as a script and the
+// program exits when it ends, with a non-zero status if any command or wait failed.
+int main(int argc, char* argv[]) {
+	string scriptPath;
+	for (int i = 1; i < argc; ++i) {
+		string argument = argv[i];
+		if (argument == "--script" && i + 1 < argc) {
+			scriptPath = argv[++i];
+		}
+		else {
+			cerr << "Usage: " << argv[0] << " [--script <file>]" << endl;
+			return 2;
+		}
+	}
+	ifstream scriptFile;
+	if (!scriptPath.empty()) {
+		scriptFile.open(scriptPath);
+		if (!scriptFile) {
+			cerr << "Cannot open script '" << scriptPath << "'." << endl;
+			return 2;
+		}
+	}
+	bool scriptMode = scriptFile.is_open() || !isatty(fileno(stdin));
+
 	Kernel::initialize();
 	ScreenManager::initialize();
 	CLIController::initialize();
 	CommandInputController::initialize();
 
-	auto mainScreen = make_shared<Screen>("main", vector<Instruction>{}, CLIController::getInstance()->getTimestamp());
-	ScreenManager::getInstance()->registerScreen("main", mainScreen);
+	auto mainScreen = make_shared<Screen>("main", vector<Instruction>{}, Clock::wallTime());
+	ScreenManager::getInstance()->registerScreen("main", mainScreen, ProcessState::CONSOLE);
 	ScreenManager::getInstance()->switchScreen("main");
-	CLIController::getInstance()->clearScreen();
+	if (!scriptMode) CLIController::getInstance()->clearScreen();
 
-	// Launch a separate thread to handle user commands.
-	std::thread inputThread(&CommandInputController::startInputLoop, CommandInputController::getInstance());
+	// Launch a separate thread to handle user commands, or to run the script.
+	int exitStatus = 0;
+	std::thread inputThread;
+	if (scriptMode) {
+		istream& script = scriptFile.is_open() ? static_cast<istream&>(scriptFile) : cin;
+		inputThread = std::thread([&script, &exitStatus]() {
+			exitStatus = CommandInputController::getInstance()->runScript(script);
+		});
+	}
+	else {
+		inputThread = std::thread(&CommandInputController::startInputLoop, CommandInputController::getInstance());
+	}
 
 	// Main simulation loop
 	while (Kernel::getInstance()->getRunningStatus()) {
 		auto scheduler = Scheduler::getInstance();
 		if (scheduler && scheduler->getSchedulerRunning()) {
+			// Each tick is charged to every core as busy or idle.
 			scheduler->incrementCpuCycles();
-
-			// Check for idle state
-			if (scheduler->getProcessQueueSize() == 0) { 
-				scheduler->incrementIdleCpuTicks();
-			}
-
 			std::this_thread::sleep_for(std::chrono::milliseconds(500));
 		}
 		else {
-			// If the scheduler is not running, we can consider this idle time as well.
-			if (scheduler) scheduler->incrementIdleCpuTicks();
 			std::this_thread::sleep_for(std::chrono::milliseconds(500));
 		}
 	}
@@ -67,5 +105,5 @@ int main() {
 	ScreenManager::destroy();
 	MemoryManager::destroy();
 	Kernel::destroy();
-	return 0;
+	return exitStatus;
 }
\ No newline at end of file
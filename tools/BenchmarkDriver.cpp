@@ -0,0 +1,222 @@
+// Headless benchmark driver. Runs the Scheduler, MemoryManager and Screen pipeline
+// without the interactive console and prints a JSON report of throughput,
+// per-process latency percentiles, fault rates and lock wait times.
+//
+// Build: g++ -std=c++17 -O2 tools/BenchmarkDriver.cpp $(ls *.cpp | grep -v '^main.cpp$') -o os-bench -pthread
+// Usage: os-bench [--config <file>] [--processes <n> | --duration <seconds>]
+//                 [--tick-ms <ms>] [--output <file>]
+//
+// With --processes, n generated processes are created at once and the run ends when
+// all of them have finished. With --duration, the batch generator runs for that many
+// seconds and the report covers the processes that finished in that time.
+#include "../Kernel.h"
+#include "../CLIController.h"
+#include "../ScreenManager.h"
+#include "../Scheduler.h"
+#include "../MemoryManager.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+using namespace std;
+
+struct BenchOptions {
+    string configPath = "config.txt";
+    int processes = 0;
+    double durationSeconds = 0;
+    int tickMs = 10;
+    string outputPath;
+};
+
+static void printUsage() {
+    cerr << "Usage: os-bench [--config <file>] [--processes <n> | --duration <seconds>] "
+        << "[--tick-ms <ms>] [--output <file>]" << endl;
+}
+
+// Parses the command line; returns false on a malformed or missing argument.
+static bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        string value = argv[++i];
+        try {
+            if (arg == "--config") options.configPath = value;
+            else if (arg == "--processes") options.processes = stoi(value);
+            else if (arg == "--duration") options.durationSeconds = stod(value);
+            else if (arg == "--tick-ms") options.tickMs = max(1, stoi(value));
+            else if (arg == "--output") options.outputPath = value;
+            else return false;
+        }
+        catch (const exception&) {
+            return false;
+        }
+    }
+    if (options.processes <= 0 && options.durationSeconds <= 0) options.processes = 100;
+    return true;
+}
+
+// Quotes a string for JSON output.
+static string jsonString(const string& value) {
+    string quoted = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// Writes {"p50":..,"p90":..,"p99":..,"max":..,"mean":..} for samples given in nanoseconds, in milliseconds.
+static void writePercentiles(ostream& out, vector<long long> samples) {
+    out << "{";
+    if (samples.empty()) {
+        out << "\"count\": 0}";
+        return;
+    }
+    sort(samples.begin(), samples.end());
+    auto at = [&](double p) {
+        size_t index = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+        return samples[index] / 1e6;
+    };
+    double total = 0;
+    for (long long s : samples) total += s;
+    out << "\"count\": " << samples.size()
+        << ", \"p50\": " << at(0.50) << ", \"p90\": " << at(0.90) << ", \"p99\": " << at(0.99)
+        << ", \"max\": " << samples.back() / 1e6 << ", \"mean\": " << total / samples.size() / 1e6 << "}";
+}
+
+// Writes a histogram summary in microseconds.
+static void writeHistogram(ostream& out, const LatencyHistogram& histogram) {
+    out << "{\"count\": " << histogram.getCount()
+        << ", \"p50Us\": " << histogram.percentileNanos(50) / 1e3
+        << ", \"p99Us\": " << histogram.percentileNanos(99) / 1e3
+        << ", \"maxUs\": " << histogram.getMaxNanos() / 1e3
+        << ", \"meanUs\": " << histogram.getAverageNanos() / 1e3 << "}";
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    // The simulator reports progress on cout; send it to stderr so stdout carries only the JSON.
+    streambuf* stdoutBuffer = cout.rdbuf(cerr.rdbuf());
+
+    ProfiledMutex::setProfilingEnabled(true);
+    Kernel::initialize();
+    ScreenManager::initialize();
+    CLIController::initialize();
+    Scheduler::initialize(options.configPath);
+    Kernel::getInstance()->setConfigInitialized(true);
+    Scheduler* scheduler = Scheduler::getInstance();
+
+    scheduler->start();
+    auto startTime = chrono::steady_clock::now();
+
+    vector<shared_ptr<Screen>> batch;
+    if (options.processes > 0) {
+        for (int i = 0; i < options.processes; ++i) {
+            batch.push_back(scheduler->spawnGeneratedProcess());
+        }
+    }
+    else {
+        scheduler->startProcessGeneration();
+    }
+
+    // Drive the CPU clock at the benchmark tick rate instead of main.cpp's 500 ms.
+    auto deadline = startTime + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(options.durationSeconds));
+    while (true) {
+        this_thread::sleep_for(chrono::milliseconds(options.tickMs));
+        scheduler->incrementCpuCycles();
+
+        if (options.processes > 0) {
+            bool allFinished = all_of(batch.begin(), batch.end(), [](const shared_ptr<Screen>& s) {
+                return s->getFinishedNanos() != 0;
+            });
+            if (allFinished) break;
+        }
+        else if (chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    auto endTime = chrono::steady_clock::now();
+    scheduler->stop();
+    double wallSeconds = chrono::duration<double>(endTime - startTime).count();
+
+    // Per-process latencies over the processes that finished during the run.
+    vector<long long> turnaround, response, wait;
+    int finished = 0, violations = 0;
+    for (const auto& screen : ScreenManager::getInstance()->snapshotProcesses().finished) {
+        long long finishedAt = screen->getFinishedNanos();
+        if (finishedAt == 0) continue;
+        finished++;
+        if (screen->hasMemoryViolation()) violations++;
+        long long turnaroundNanos = finishedAt - screen->getCreatedNanos();
+        turnaround.push_back(turnaroundNanos);
+        response.push_back(screen->getFirstDispatchNanos() - screen->getCreatedNanos());
+        wait.push_back(max(0LL, turnaroundNanos - screen->getCpuNanos()));
+    }
+
+    MemoryManager* memory = MemoryManager::getInstance();
+    long long instructions = scheduler->getInstructionsExecuted();
+    long long faults = static_cast<long long>(memory->getMinorFaultCount()) + memory->getMajorFaultCount();
+
+    ostringstream json;
+    json << fixed << setprecision(3);
+    json << "{\n";
+    json << "  \"config\": {\"file\": " << jsonString(options.configPath) << ", \"cores\": " << scheduler->getNumCores()
+        << ", \"scheduler\": \"" << scheduler->getAlgorithm() << "\", \"quantum\": " << scheduler->getQuantumCycles()
+        << ", \"mode\": \"" << (options.processes > 0 ? "processes" : "duration") << "\""
+        << ", \"processes\": " << options.processes << ", \"durationSeconds\": " << options.durationSeconds
+        << ", \"tickMs\": " << options.tickMs << ", \"seed\": " << scheduler->getRunSeed() << "},\n";
+    json << "  \"wallSeconds\": " << wallSeconds << ",\n";
+    json << "  \"ticks\": " << scheduler->getCpuCycles() << ",\n";
+    json << "  \"cpuUtilization\": " << scheduler->getAggregateCoreStats().utilization() << ",\n";
+    json << "  \"processesFinished\": " << finished << ",\n";
+    json << "  \"memoryViolations\": " << violations << ",\n";
+    json << "  \"instructionsExecuted\": " << instructions << ",\n";
+    json << "  \"instructionsPerSec\": " << instructions / wallSeconds << ",\n";
+    json << "  \"processesPerSec\": " << finished / wallSeconds << ",\n";
+    json << "  \"turnaroundMs\": "; writePercentiles(json, turnaround); json << ",\n";
+    json << "  \"responseMs\": "; writePercentiles(json, response); json << ",\n";
+    json << "  \"waitMs\": "; writePercentiles(json, wait); json << ",\n";
+    json << "  \"faults\": {\"minor\": " << memory->getMinorFaultCount() << ", \"major\": " << memory->getMajorFaultCount()
+        << ", \"pagedIn\": " << memory->getPagedInCount() << ", \"pagedOut\": " << memory->getPagedOutCount()
+        << ", \"perSec\": " << faults / wallSeconds
+        << ", \"perKiloInstruction\": " << (instructions > 0 ? faults * 1000.0 / instructions : 0.0)
+        << ", \"serviceLatency\": "; writeHistogram(json, memory->getFaultServiceLatency()); json << "},\n";
+    json << "  \"locks\": [";
+    vector<LockStats> locks = ProfiledMutex::getAllStats();
+    for (size_t i = 0; i < locks.size(); ++i) {
+        const LockStats& lock = locks[i];
+        json << (i ? ",\n" : "\n") << "    {\"name\": " << jsonString(lock.name) << ", \"acquisitions\": " << lock.acquisitions
+            << ", \"contended\": " << lock.contended << ", \"totalWaitMs\": " << lock.totalWaitNanos / 1e6
+            << ", \"maxWaitUs\": " << lock.maxWaitNanos / 1e3 << ", \"totalHoldMs\": " << lock.totalHoldNanos / 1e6
+            << ", \"maxHoldUs\": " << lock.maxHoldNanos / 1e3 << "}";
+    }
+    json << "\n  ]\n";
+    json << "}\n";
+
+    cout.rdbuf(stdoutBuffer);
+    if (options.outputPath.empty()) {
+        cout << json.str();
+    }
+    else {
+        ofstream out(options.outputPath);
+        out << json.str();
+        cerr << "Wrote " << options.outputPath << endl;
+    }
+
+    ScreenManager::destroy();
+    CLIController::destroy();
+    MemoryManager::destroy();
+    Kernel::destroy();
+    return 0;
+}
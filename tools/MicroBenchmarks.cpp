@@ -0,0 +1,343 @@
+// Microbenchmarks for the simulator's hot paths: MemoryManager reads and writes on
+// hits and on faults, Screen::execute per instruction type, Scheduler::addProcessToQueue
+// under contention, CLIController::getTimestamp and generateInstructionsForProcess.
+// Each case is swept over frame size, thread (core) count or process count.
+//
+// Build: g++ -std=c++17 -O2 tools/MicroBenchmarks.cpp $(ls *.cpp | grep -v '^main.cpp$') -o os-microbench -pthread
+// Usage: os-microbench [--config <file>] [--filter <text>] [--repeats <n>]
+//                      [--save-baseline <file>] [--baseline <file>] [--threshold <percent>]
+//
+// With --baseline, every case is compared to the stored ns/op and the program exits
+// with status 1 if any case is slower than the baseline by more than the threshold.
+#include "../Kernel.h"
+#include "../CLIController.h"
+#include "../Clock.h"
+#include "../ScreenManager.h"
+#include "../Scheduler.h"
+#include "../MemoryManager.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <atomic>
+using namespace std;
+
+struct MicroOptions {
+    string configPath = "config.txt";
+    string filter;
+    int repeats = 5;
+    string saveBaselinePath;
+    string baselinePath;
+    double thresholdPercent = 30;
+};
+
+struct MicroResult {
+    string name;
+    double nanosPerOp;
+};
+
+// Publishes a benchmark's result so the optimizer cannot drop the loop that computed it.
+// The sink is atomic because cases running on several threads all feed it.
+static void doNotOptimize(size_t value) {
+    static atomic<size_t> sink{ 0 };
+    sink.store(value, memory_order_relaxed);
+}
+
+static void printUsage() {
+    cerr << "Usage: os-microbench [--config <file>] [--filter <text>] [--repeats <n>] "
+        << "[--save-baseline <file>] [--baseline <file>] [--threshold <percent>]" << endl;
+}
+
+// Parses the command line; returns false on a malformed or missing argument.
+static bool parseOptions(int argc, char* argv[], MicroOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        string value = argv[++i];
+        try {
+            if (arg == "--config") options.configPath = value;
+            else if (arg == "--filter") options.filter = value;
+            else if (arg == "--repeats") options.repeats = max(1, stoi(value));
+            else if (arg == "--save-baseline") options.saveBaselinePath = value;
+            else if (arg == "--baseline") options.baselinePath = value;
+            else if (arg == "--threshold") options.thresholdPercent = stod(value);
+            else return false;
+        }
+        catch (const exception&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Runs a benchmark case and records its median ns/op over the configured repeats.
+// setup runs untimed before each repeat; body performs ops operations and is timed.
+class MicroSuite {
+public:
+    explicit MicroSuite(const MicroOptions& options) : options(options) {}
+
+    void run(const string& name, long long ops, function<void()> setup, function<void()> body) {
+        if (!options.filter.empty() && name.find(options.filter) == string::npos) return;
+
+        vector<double> samples;
+        for (int r = 0; r < options.repeats; ++r) {
+            if (setup) setup();
+            auto start = chrono::steady_clock::now();
+            body();
+            auto elapsed = chrono::steady_clock::now() - start;
+            samples.push_back(chrono::duration<double, nano>(elapsed).count() / ops);
+        }
+        sort(samples.begin(), samples.end());
+        results.push_back({ name, samples[samples.size() / 2] });
+    }
+
+    const vector<MicroResult>& getResults() const { return results; }
+
+private:
+    const MicroOptions& options;
+    vector<MicroResult> results;
+};
+
+// Recreates the MemoryManager with the given geometry.
+static void resetMemory(int totalMemory, int frameSize) {
+    MemoryManager::destroy();
+    MemoryManager::initialize(totalMemory, frameSize);
+}
+
+// Reads or writes addresses on the pages of each process in turn.
+static void accessPages(const vector<string>& processes, int pages, int frameSize, long long ops, bool write) {
+    MemoryManager* memory = MemoryManager::getInstance();
+    uint16_t value = 0;
+    for (long long i = 0; i < ops; ++i) {
+        const string& process = processes[i % processes.size()];
+        uint16_t address = static_cast<uint16_t>((i / processes.size()) % pages * frameSize);
+        if (write) memory->writeMemory(process, address, static_cast<uint16_t>(i));
+        else memory->readMemory(process, address, value);
+    }
+    doNotOptimize(value);
+}
+
+static void benchmarkMemory(MicroSuite& suite) {
+    const long long ops = 200000;
+    vector<string> processes;
+
+    // Hits: each process touches one resident page.
+    for (int frameSize : { 16, 64, 256 }) {
+        for (bool write : { false, true }) {
+            string name = string("memory/") + (write ? "write" : "read") + "-hit/frame=" + to_string(frameSize);
+            suite.run(name, ops, [&]() {
+                resetMemory(frameSize * 64, frameSize);
+                processes = { "hit" };
+                MemoryManager::getInstance()->setupProcessMemory("hit", frameSize * 4);
+                accessPages(processes, 1, frameSize, 1, write);
+            }, [&]() { accessPages(processes, 1, frameSize, ops, write); });
+        }
+    }
+
+    // Hits spread over more processes, one resident page each.
+    for (int processCount : { 1, 8, 64 }) {
+        string name = "memory/read-hit/processes=" + to_string(processCount);
+        suite.run(name, ops, [&]() {
+            resetMemory(64 * 128, 64);
+            processes.clear();
+            for (int p = 0; p < processCount; ++p) {
+                processes.push_back("proc" + to_string(p));
+                MemoryManager::getInstance()->setupProcessMemory(processes.back(), 256);
+            }
+            accessPages(processes, 1, 64, processCount, false);
+        }, [&]() { accessPages(processes, 1, 64, ops, false); });
+    }
+
+    // Faults: eight pages cycled through four frames, so every access evicts (FIFO).
+    const long long faultOps = 2000;
+    for (int frameSize : { 16, 64, 256 }) {
+        for (bool write : { false, true }) {
+            string name = string("memory/") + (write ? "write" : "read") + "-fault/frame=" + to_string(frameSize);
+            suite.run(name, faultOps, [&]() {
+                resetMemory(frameSize * 4, frameSize);
+                processes = { "fault" };
+                MemoryManager::getInstance()->setupProcessMemory("fault", frameSize * 8);
+            }, [&]() { accessPages(processes, 8, frameSize, faultOps, write); });
+        }
+    }
+}
+
+// Builds a program of count copies of one instruction type.
+static vector<Instruction> programOf(InstructionType type, int count) {
+    vector<Instruction> program;
+    for (int i = 0; i < count; ++i) {
+        Instruction instruction;
+        instruction.type = type;
+        string variable = "var_" + to_string(i % 8);
+        switch (type) {
+        case InstructionType::DECLARE:
+            instruction.operands = { {true, variable, 0}, {false, "", 5} };
+            break;
+        case InstructionType::ADD:
+        case InstructionType::SUBTRACT:
+            instruction.operands = { {true, variable, 0}, {true, variable, 0}, {false, "", 1} };
+            break;
+        case InstructionType::PRINT:
+            instruction.printMessage = "Value from: %" + variable + "%";
+            instruction.operands = { {true, variable, 0} };
+            break;
+        case InstructionType::SLEEP:
+            instruction.operands = { {false, "", 0} };
+            break;
+        case InstructionType::READ:
+            instruction.operands = { {true, variable, 0} };
+            instruction.memoryAddress = 0x100;
+            break;
+        case InstructionType::WRITE:
+            instruction.operands = { {true, variable, 0} };
+            instruction.memoryAddress = 0x100;
+            break;
+        default:
+            break;
+        }
+        program.push_back(instruction);
+    }
+    return program;
+}
+
+static void benchmarkExecute(MicroSuite& suite) {
+    const int count = 5000;
+    const pair<const char*, InstructionType> types[] = {
+        { "DECLARE", InstructionType::DECLARE }, { "ADD", InstructionType::ADD },
+        { "SUBTRACT", InstructionType::SUBTRACT }, { "PRINT", InstructionType::PRINT },
+        { "SLEEP", InstructionType::SLEEP }, { "READ", InstructionType::READ },
+        { "WRITE", InstructionType::WRITE }
+    };
+
+    shared_ptr<Screen> screen;
+    for (const auto& [typeName, type] : types) {
+        vector<Instruction> program = programOf(type, count);
+        suite.run(string("screen/execute/") + typeName, count, [&]() {
+            resetMemory(64 * 64, 64);
+            screen = make_shared<Screen>("exec", program, Clock::wallTime());
+            MemoryManager::getInstance()->setupProcessMemory("exec", 1024);
+        }, [&]() { doNotOptimize(static_cast<size_t>(screen->execute(-1))); });
+    }
+}
+
+// Runs body(thread index) on the given number of threads at once.
+static void runOnThreads(int threads, const function<void(int)>& body) {
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) workers.emplace_back(body, t);
+    for (auto& worker : workers) worker.join();
+}
+
+static void benchmarkContention(MicroSuite& suite) {
+    const int perThread = 20000;
+    auto process = make_shared<Screen>("queued", vector<Instruction>{}, Clock::wallTime());
+
+    // The workers are never started, so the queue only grows; each case pushes a fresh batch.
+    for (int threads : { 1, 2, 4, 8 }) {
+        suite.run("scheduler/add-to-queue/threads=" + to_string(threads), static_cast<long long>(threads) * perThread, nullptr, [&]() {
+            runOnThreads(threads, [&](int) {
+                for (int i = 0; i < perThread; ++i) Scheduler::getInstance()->addProcessToQueue(process);
+            });
+        });
+    }
+
+    const int stamps = 20000;
+    for (int threads : { 1, 2, 4, 8 }) {
+        suite.run("cli/get-timestamp/threads=" + to_string(threads), static_cast<long long>(threads) * stamps, nullptr, [&]() {
+            runOnThreads(threads, [&](int) {
+                size_t length = 0;
+                for (int i = 0; i < stamps; ++i) length += CLIController::getInstance()->getTimestamp().size();
+                doNotOptimize(length);
+            });
+        });
+    }
+}
+
+static void benchmarkGeneration(MicroSuite& suite) {
+    for (int processCount : { 1, 16, 64 }) {
+        suite.run("scheduler/generate-instructions/processes=" + to_string(processCount), processCount, nullptr, [&]() {
+            size_t total = 0;
+            for (int p = 0; p < processCount; ++p) {
+                total += Scheduler::getInstance()->generateInstructionsForProcess("gen" + to_string(p), 4096).size();
+            }
+            doNotOptimize(total);
+        });
+    }
+}
+
+// Reads a baseline written by --save-baseline: one "<name> <ns/op>" line per case.
+static map<string, double> loadBaseline(const string& path) {
+    map<string, double> baseline;
+    ifstream in(path);
+    string name;
+    double nanos;
+    while (in >> name >> nanos) baseline[name] = nanos;
+    return baseline;
+}
+
+int main(int argc, char* argv[]) {
+    MicroOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    Kernel::initialize();
+    ScreenManager::initialize();
+    CLIController::initialize();
+    Scheduler::initialize(options.configPath);
+    MemoryManager::initialize(64 * 64, 64);
+
+    MicroSuite suite(options);
+    benchmarkMemory(suite);
+    benchmarkExecute(suite);
+    benchmarkContention(suite);
+    benchmarkGeneration(suite);
+
+    map<string, double> baseline;
+    if (!options.baselinePath.empty()) {
+        baseline = loadBaseline(options.baselinePath);
+        if (baseline.empty()) cerr << "Warning: baseline '" << options.baselinePath << "' is empty or missing." << endl;
+    }
+
+    int regressions = 0;
+    cout << left << setw(48) << "Benchmark" << right << setw(14) << "ns/op";
+    if (!baseline.empty()) cout << setw(14) << "baseline" << setw(10) << "change";
+    cout << "\n";
+    cout << fixed << setprecision(1);
+    for (const auto& result : suite.getResults()) {
+        cout << left << setw(48) << result.name << right << setw(14) << result.nanosPerOp;
+        auto it = baseline.find(result.name);
+        if (it != baseline.end() && it->second > 0) {
+            double change = (result.nanosPerOp - it->second) / it->second * 100;
+            bool regressed = change > options.thresholdPercent;
+            if (regressed) regressions++;
+            cout << setw(14) << it->second << setw(9) << showpos << change << "%" << noshowpos
+                << (regressed ? "  REGRESSION" : "");
+        }
+        cout << "\n";
+    }
+
+    if (!options.saveBaselinePath.empty()) {
+        ofstream out(options.saveBaselinePath);
+        out << setprecision(3) << fixed;
+        for (const auto& result : suite.getResults()) out << result.name << " " << result.nanosPerOp << "\n";
+        cout << "Baseline saved to " << options.saveBaselinePath << "\n";
+    }
+
+    if (regressions > 0) {
+        cout << regressions << " benchmark(s) regressed by more than " << options.thresholdPercent << "%.\n";
+    }
+
+    MemoryManager::destroy();
+    ScreenManager::destroy();
+    CLIController::destroy();
+    Kernel::destroy();
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,288 @@
+// Offline replay of a memory access trace recorded with the 'memtrace' command.
+// Simulates FIFO (MemoryManager::findVictimFrame), CLOCK, LRU and Belady's OPT
+// over the same trace and prints fault counts per policy and frame count.
+//
+// Build: g++ -std=c++17 -O2 tools/TraceReplay.cpp -o trace-replay
+// Usage: trace-replay <trace-file> [frames ...]
+#include "../MemoryTraceRecorder.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <list>
+#include <queue>
+#include <string>
+#include <cstring>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
+using namespace std;
+
+// A page of a particular process, packed into one key.
+using PageKey = uint64_t;
+static PageKey makeKey(uint32_t processId, uint32_t page) {
+    return (static_cast<uint64_t>(processId) << 32) | page;
+}
+static uint32_t keyProcess(PageKey key) {
+    return static_cast<uint32_t>(key >> 32);
+}
+
+struct ReplayResult {
+    long long faults = 0;
+    long long writebacks = 0;
+};
+
+// Common frame bookkeeping shared by all policies: which page each frame holds and
+// a free list in the same order MemoryManager hands frames out.
+class ReplacementPolicy {
+public:
+    explicit ReplacementPolicy(int numFrames)
+        : numFrames(numFrames), frames(numFrames, EMPTY), dirty(numFrames, false) {
+        for (int i = 0; i < numFrames; ++i) freeFrames.push_back(i);
+    }
+    virtual ~ReplacementPolicy() = default;
+    virtual string name() const = 0;
+
+    // Processes one access; index is the position of the access in the trace.
+    void access(PageKey key, bool write, size_t index, ReplayResult& result) {
+        auto it = residentFrame.find(key);
+        int frame;
+        if (it != residentFrame.end()) {
+            frame = it->second;
+            onHit(frame, index);
+        }
+        else {
+            result.faults++;
+            if (!freeFrames.empty()) {
+                frame = freeFrames.front();
+                freeFrames.pop_front();
+            }
+            else {
+                frame = chooseVictim(index);
+                if (dirty[frame]) result.writebacks++;
+                residentFrame.erase(frames[frame]);
+            }
+            frames[frame] = key;
+            dirty[frame] = false;
+            residentFrame[key] = frame;
+            onLoad(frame, index);
+        }
+        if (write) dirty[frame] = true;
+    }
+
+    // Frees every frame of an exited process, like MemoryManager::deallocate.
+    void release(uint32_t processId) {
+        for (int frame = 0; frame < numFrames; ++frame) {
+            if (frames[frame] != EMPTY && keyProcess(frames[frame]) == processId) {
+                residentFrame.erase(frames[frame]);
+                frames[frame] = EMPTY;
+                dirty[frame] = false;
+                onRelease(frame);
+                freeFrames.push_back(frame);
+            }
+        }
+    }
+
+protected:
+    static constexpr PageKey EMPTY = numeric_limits<PageKey>::max();
+
+    virtual int chooseVictim(size_t index) = 0;
+    virtual void onHit(int /*frame*/, size_t /*index*/) {}
+    virtual void onLoad(int /*frame*/, size_t /*index*/) {}
+    virtual void onRelease(int /*frame*/) {}
+
+    int numFrames;
+    vector<PageKey> frames;
+    vector<bool> dirty;
+    list<int> freeFrames;
+    unordered_map<PageKey, int> residentFrame;
+};
+
+// The live policy: a victim pointer that walks the frames round-robin.
+class FifoPolicy : public ReplacementPolicy {
+public:
+    using ReplacementPolicy::ReplacementPolicy;
+    string name() const override { return "FIFO"; }
+protected:
+    int chooseVictim(size_t) override {
+        int victim = nextVictim;
+        nextVictim = (nextVictim + 1) % numFrames;
+        return victim;
+    }
+private:
+    int nextVictim = 0;
+};
+
+// Second-chance clock with one reference bit per frame.
+class ClockPolicy : public ReplacementPolicy {
+public:
+    explicit ClockPolicy(int numFrames) : ReplacementPolicy(numFrames), referenced(numFrames, false) {}
+    string name() const override { return "CLOCK"; }
+protected:
+    int chooseVictim(size_t) override {
+        while (referenced[hand]) {
+            referenced[hand] = false;
+            hand = (hand + 1) % numFrames;
+        }
+        int victim = hand;
+        hand = (hand + 1) % numFrames;
+        return victim;
+    }
+    void onHit(int frame, size_t) override { referenced[frame] = true; }
+    void onLoad(int frame, size_t) override { referenced[frame] = true; }
+    void onRelease(int frame) override { referenced[frame] = false; }
+private:
+    vector<bool> referenced;
+    int hand = 0;
+};
+
+// Least recently used, kept as a recency list of frames.
+class LruPolicy : public ReplacementPolicy {
+public:
+    explicit LruPolicy(int numFrames) : ReplacementPolicy(numFrames), positions(numFrames) {}
+    string name() const override { return "LRU"; }
+protected:
+    int chooseVictim(size_t) override {
+        int victim = recency.back();
+        recency.pop_back();
+        return victim;
+    }
+    void onHit(int frame, size_t) override {
+        recency.splice(recency.begin(), recency, positions[frame]);
+    }
+    void onLoad(int frame, size_t) override {
+        recency.push_front(frame);
+        positions[frame] = recency.begin();
+    }
+    void onRelease(int frame) override {
+        recency.erase(positions[frame]);
+    }
+private:
+    list<int> recency; // front = most recently used
+    vector<list<int>::iterator> positions;
+};
+
+// Belady's optimal policy: evict the page whose next use is furthest in the future.
+class OptPolicy : public ReplacementPolicy {
+public:
+    OptPolicy(int numFrames, const vector<size_t>& nextUse)
+        : ReplacementPolicy(numFrames), nextUse(nextUse), frameNextUse(numFrames, 0) {}
+    string name() const override { return "OPT"; }
+protected:
+    int chooseVictim(size_t) override {
+        // Lazily skip heap entries that no longer describe the frame.
+        while (true) {
+            auto top = heap.top();
+            heap.pop();
+            if (frames[top.second] != EMPTY && frameNextUse[top.second] == top.first) return top.second;
+        }
+    }
+    void onHit(int frame, size_t index) override { schedule(frame, index); }
+    void onLoad(int frame, size_t index) override { schedule(frame, index); }
+private:
+    void schedule(int frame, size_t index) {
+        frameNextUse[frame] = nextUse[index];
+        heap.push({ nextUse[index], frame });
+    }
+    const vector<size_t>& nextUse;
+    vector<size_t> frameNextUse;
+    priority_queue<pair<size_t, int>> heap; // max-heap on next use
+};
+
+// Reads the whole trace into memory.
+static bool loadTrace(const string& path, TraceFileHeader& header, vector<TraceRecord>& records) {
+    ifstream file(path, ios::binary);
+    if (!file) return false;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || memcmp(header.magic, "CSMT", 4) != 0) {
+        return false;
+    }
+    file.seekg(0, ios::end);
+    size_t bytes = static_cast<size_t>(file.tellg()) - sizeof(header);
+    file.seekg(sizeof(header), ios::beg);
+    records.resize(bytes / sizeof(TraceRecord));
+    file.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(TraceRecord));
+    return true;
+}
+
+// For every access, the index of the next access to the same page (or "never").
+// A process exit ends the reuse of all its pages.
+static vector<size_t> computeNextUse(const vector<TraceRecord>& records) {
+    const size_t never = numeric_limits<size_t>::max();
+    vector<size_t> nextUse(records.size(), never);
+    unordered_map<PageKey, size_t> upcoming;
+    for (size_t i = records.size(); i-- > 0;) {
+        const auto& record = records[i];
+        if (record.kind() == TraceAccessKind::RELEASE) {
+            for (auto it = upcoming.begin(); it != upcoming.end();) {
+                it = (keyProcess(it->first) == record.processId) ? upcoming.erase(it) : std::next(it);
+            }
+            continue;
+        }
+        PageKey key = makeKey(record.processId, record.page());
+        auto it = upcoming.find(key);
+        if (it != upcoming.end()) nextUse[i] = it->second;
+        upcoming[key] = i;
+    }
+    return nextUse;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <trace-file> [frames ...]" << endl;
+        return 1;
+    }
+
+    TraceFileHeader header;
+    vector<TraceRecord> records;
+    if (!loadTrace(argv[1], header, records)) {
+        cerr << "Could not read trace file '" << argv[1] << "'." << endl;
+        return 1;
+    }
+
+    vector<int> frameCounts;
+    for (int i = 2; i < argc; ++i) {
+        int frames = atoi(argv[i]);
+        if (frames > 0) frameCounts.push_back(frames);
+    }
+    if (frameCounts.empty()) frameCounts.push_back(static_cast<int>(header.numFrames));
+
+    long long accesses = count_if(records.begin(), records.end(),
+        [](const TraceRecord& record) { return record.kind() != TraceAccessKind::RELEASE; });
+    cout << "Trace: " << argv[1] << " (" << accesses << " accesses, mem-per-frame "
+        << header.frameSize << ", recorded with " << header.numFrames << " frames)" << endl;
+
+    vector<size_t> nextUse = computeNextUse(records);
+
+    cout << left << setw(8) << "Frames" << setw(8) << "Policy" << right << setw(12) << "Faults"
+        << setw(10) << "Rate" << setw(12) << "Writebacks" << setw(14) << "Accesses/s" << endl;
+    for (int frames : frameCounts) {
+        vector<unique_ptr<ReplacementPolicy>> policies;
+        policies.push_back(make_unique<FifoPolicy>(frames));
+        policies.push_back(make_unique<ClockPolicy>(frames));
+        policies.push_back(make_unique<LruPolicy>(frames));
+        policies.push_back(make_unique<OptPolicy>(frames, nextUse));
+
+        for (auto& policy : policies) {
+            ReplayResult result;
+            auto start = chrono::steady_clock::now();
+            for (size_t i = 0; i < records.size(); ++i) {
+                const auto& record = records[i];
+                if (record.kind() == TraceAccessKind::RELEASE) {
+                    policy->release(record.processId);
+                }
+                else {
+                    policy->access(makeKey(record.processId, record.page()), record.kind() == TraceAccessKind::WRITE, i, result);
+                }
+            }
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            cout << left << setw(8) << frames << setw(8) << policy->name() << right << setw(12) << result.faults
+                << setw(9) << fixed << setprecision(2) << (accesses > 0 ? 100.0 * result.faults / accesses : 0.0) << "%"
+                << setw(12) << result.writebacks
+                << setw(14) << setprecision(0) << (seconds > 0 ? accesses / seconds : 0.0) << endl;
+        }
+    }
+    return 0;
+}